@@ -0,0 +1,112 @@
+/*
+ * Tencent is pleased to support the open source community by making wwsearch
+ * available.
+ *
+ * Copyright (C) 2018-present Tencent. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * https://opensource.org/licenses/Apache-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OF ANY KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+#pragma once
+
+#include "document.h"
+#include "header.h"
+
+namespace wwsearch {
+
+enum kAggregationMetricType {
+  kAggregationCount = 1,  // documents having the field
+  kAggregationSum = 2,
+  kAggregationMin = 3,
+  kAggregationMax = 4,
+};
+
+// Metric value of one bucket.Only numeric field is summed/compared,count
+// is number of documents having the field,numeric_count of those numeric.
+struct AggregationMetricValue {
+  uint64_t count;
+  uint64_t numeric_count;
+  uint64_t sum;
+  uint64_t min;
+  uint64_t max;
+
+  AggregationMetricValue()
+      : count(0), numeric_count(0), sum(0), min(UINT64_MAX), max(0) {}
+
+  uint64_t Value(kAggregationMetricType type) const;
+};
+
+struct AggregationBucket {
+  // Group key,string_key for string field,numeric_key for numeric field and
+  // lower bound of histogram bucket.
+  bool is_string;
+  std::string string_key;
+  uint64_t numeric_key;
+  uint64_t doc_count;
+  // Same order as metrics added.
+  std::vector<AggregationMetricValue> metrics;
+
+  AggregationBucket() : is_string(false), numeric_key(0), doc_count(0) {}
+};
+
+/* Notice : Group by & metrics over docvalue of match documents.
+ * Without group by,all documents are in one bucket.
+ * Documents are added by TopNCollector after filter,so only buckets are
+ * kept in memory.
+ */
+class Aggregation {
+ private:
+  enum kGroupType { kGroupNone = 0, kGroupTerms = 1, kGroupHistogram = 2 };
+
+  kGroupType group_type_;
+  FieldID group_field_id_;
+  uint64_t interval_;
+  size_t max_buckets_;
+  std::vector<std::pair<kAggregationMetricType, FieldID>> metrics_;
+  std::unordered_map<std::string, AggregationBucket> buckets_;
+  // documents without group field.
+  uint64_t missing_doc_count_;
+
+ public:
+  Aggregation()
+      : group_type_(kGroupNone),
+        group_field_id_(0),
+        interval_(0),
+        max_buckets_(SIZE_MAX),
+        missing_doc_count_(0) {}
+
+  virtual ~Aggregation() {}
+
+  // One bucket per distinct value of field.
+  void GroupByTerms(FieldID field_id);
+
+  // One bucket per [n * interval,(n+1) * interval) of numeric field.
+  void GroupByHistogram(FieldID field_id, uint64_t interval);
+
+  // Only top max_buckets buckets by doc count are returned.
+  void SetMaxBuckets(size_t max_buckets) { this->max_buckets_ = max_buckets; }
+
+  void AddMetric(kAggregationMetricType type, FieldID field_id);
+
+  void Collect(Document *document);
+
+  // Terms buckets ordered by doc count desc,histogram buckets by key asc.
+  void GetBuckets(std::vector<AggregationBucket> &buckets);
+
+  uint64_t MissingDocCount() { return this->missing_doc_count_; }
+
+  void Clear();
+
+ private:
+};
+
+}  // namespace wwsearch
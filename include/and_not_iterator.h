@@ -0,0 +1,65 @@
+/*
+ * Tencent is pleased to support the open source community by making wwsearch
+ * available.
+ *
+ * Copyright (C) 2018-present Tencent. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * https://opensource.org/licenses/Apache-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OF ANY KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+#pragma once
+#include "doc_iterator.h"
+
+namespace wwsearch {
+
+/* Notice : Doc list of required iterator minus excluded iterators.
+ * Excluded iterators advance in lockstep to each candidate of required
+ * one,so they are never walked beyond it.
+ */
+class AndNotIterator : public DocIdSetIterator {
+ private:
+  DocIdSetIterator* required_iterator_;
+  std::vector<DocIdSetIterator*> excluded_iterator_;
+  DocumentID curr_;
+
+ public:
+  AndNotIterator() : required_iterator_(nullptr), curr_(NO_MORE_DOCS) {}
+
+  virtual ~AndNotIterator() {}
+
+  virtual DocumentID DocID() override;
+
+  virtual DocumentID NextDoc() override;
+
+  virtual DocumentID Advance(DocumentID target) override;
+
+  // upper bound,same as required iterator.
+  virtual CostType Cost() override;
+
+  virtual int FieldId() override;
+
+  void SetRequiredIterator(DocIdSetIterator* iterator) {
+    this->required_iterator_ = iterator;
+  }
+
+  void AddExcludedIterator(DocIdSetIterator* iterator) {
+    this->excluded_iterator_.push_back(iterator);
+  }
+
+  // must call after required iterator is ready.
+  void FinishAddIterator();
+
+ private:
+  // First candidate not in excluded doc lists from candidate.
+  DocumentID SkipExcluded(DocumentID candidate);
+};
+}  // namespace wwsearch
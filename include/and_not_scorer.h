@@ -0,0 +1,62 @@
+/*
+ * Tencent is pleased to support the open source community by making wwsearch
+ * available.
+ *
+ * Copyright (C) 2018-present Tencent. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * https://opensource.org/licenses/Apache-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OF ANY KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+#pragma once
+
+#include "and_not_iterator.h"
+#include "and_not_weight.h"
+#include "merge_iterator.h"
+#include "scorer.h"
+
+namespace wwsearch {
+
+class AndNotScorer : public Scorer {
+ private:
+  std::vector<Scorer *> sub_scorer_;
+  MergeIterator required_iterator_;
+  AndNotIterator iterator_;
+
+ public:
+  AndNotScorer(AndNotWeight *weight) : Scorer(weight, "AndNotScorer") {
+    iterator_.SetRequiredIterator(&required_iterator_);
+  }
+
+  virtual ~AndNotScorer() {
+    // our response to delete scorer
+    for (auto s : sub_scorer_) delete s;
+  }
+
+  virtual DocumentID DocID() override;
+
+  virtual double Score() override;
+
+  virtual DocIdSetIterator &Iterator() override;
+
+  void AddScorer(Scorer *s) {
+    this->sub_scorer_.push_back(s);
+    this->required_iterator_.AddSubIterator(&(s->Iterator()));
+  }
+
+  void AddNotScorer(Scorer *s) {
+    this->sub_scorer_.push_back(s);
+    this->iterator_.AddExcludedIterator(&(s->Iterator()));
+  }
+
+ private:
+};
+}  // namespace wwsearch
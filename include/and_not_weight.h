@@ -0,0 +1,54 @@
+/*
+ * Tencent is pleased to support the open source community by making wwsearch
+ * available.
+ *
+ * Copyright (C) 2018-present Tencent. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * https://opensource.org/licenses/Apache-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OF ANY KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+#pragma once
+
+#include "and_not_query.h"
+#include "weight.h"
+
+namespace wwsearch {
+
+class AndNotWeight : public Weight {
+ private:
+  std::vector<Weight*> required_weight_;
+  std::vector<Weight*> excluded_weight_;
+
+ public:
+  AndNotWeight(AndNotQuery* query) : Weight(query, "AndNotWeight") {}
+
+  virtual ~AndNotWeight() {
+    // our response to delete sub weight
+    for (auto w : required_weight_) {
+      delete w;
+    }
+    for (auto w : excluded_weight_) {
+      delete w;
+    }
+  }
+
+  virtual Scorer* GetScorer(SearchContext* context) override;
+
+  virtual BulkScorer* GetBulkScorer(SearchContext* context) override;
+
+  void AddWeight(Weight* w) { this->required_weight_.push_back(w); }
+
+  void AddNotWeight(Weight* w) { this->excluded_weight_.push_back(w); }
+
+ private:
+};
+}  // namespace wwsearch
@@ -37,6 +37,8 @@ class AndQuery : public Query {
 
   void AddQuery(Query* query) { sub_query_.push_back(query); }
 
+  inline const std::vector<Query*>& SubQuery() { return sub_query_; }
+
  private:
 };
 }  // namespace wwsearch
\ No newline at end of file
@@ -0,0 +1,101 @@
+/*
+ * Tencent is pleased to support the open source community by making wwsearch
+ * available.
+ *
+ * Copyright (C) 2018-present Tencent. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * https://opensource.org/licenses/Apache-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OF ANY KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+#pragma once
+
+#include <functional>
+#include <list>
+#include "filter.h"
+#include "query.h"
+#include "search_context.h"
+#include "search_deadline.h"
+#include "search_status.h"
+#include "sorter.h"
+#include "tracer.h"
+
+namespace wwsearch {
+
+class FilterPushdown;
+class QueryRewriter;
+class Scorer;
+class Searcher;
+class ThreadPool;
+class TopNCollector;
+class Weight;
+
+// Called on executor thread when query finish.
+typedef std::function<void(SearchStatus &status, std::list<DocumentID> &docs)>
+    SearchCallback;
+
+/* Notice:
+ * State of one query run by Searcher::DoQueryAsync.
+ * Query is split into stages,each stage is one task of executor:
+ * 1. Open snapshot,plan query and read doc lists.
+ * 2. Collect one batch of documents,read docvalue of it,repeat.
+ * Thread is released between stages,so queries in flight are not bounded
+ * by executor threads and a long query does not block short ones.
+ * It deletes itself after callback.
+ */
+class AsyncQuery {
+ private:
+  Searcher *searcher_;
+  IndexConfig *config_;
+  ThreadPool *executor_;
+  TableID table_;
+  Query *query_;
+  size_t offset_;
+  size_t limit_;
+  std::vector<Filter *> *filter_;
+  std::vector<SortCondition *> *sorter_;
+  uint32_t min_match_filter_num_;
+  SearchDeadline *deadline_;
+  SearchCallback callback_;
+
+  VirtualDBSnapshot *snapshot_;
+  SearchContext *context_;
+  FilterPushdown *pushdown_;
+  QueryRewriter *rewriter_;
+  Weight *weight_;
+  Scorer *scorer_;
+  TopNCollector *collector_;
+  SearchTracer tracer_;
+
+ public:
+  AsyncQuery(Searcher *searcher, IndexConfig *config, ThreadPool *executor,
+             const TableID &table, Query &query, size_t offset, size_t limit,
+             std::vector<Filter *> *filter,
+             std::vector<SortCondition *> *sorter,
+             uint32_t min_match_filter_num, SearchDeadline *deadline,
+             SearchCallback callback);
+
+  virtual ~AsyncQuery();
+
+  AsyncQuery(const AsyncQuery &) = delete;
+  AsyncQuery &operator=(const AsyncQuery &) = delete;
+
+  void Start();
+
+ private:
+  void Open();
+
+  void CollectBatch();
+
+  void Done(SearchStatus status);
+};
+
+}  // namespace wwsearch
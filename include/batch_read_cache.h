@@ -0,0 +1,70 @@
+/*
+ * Tencent is pleased to support the open source community by making wwsearch
+ * available.
+ *
+ * Copyright (C) 2018-present Tencent. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * https://opensource.org/licenses/Apache-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OF ANY KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+#pragma once
+
+#include "header.h"
+#include "search_status.h"
+#include "storage_type.h"
+
+namespace wwsearch {
+
+/* Notice : Values read by one batch of queries on the same snapshot.
+ * Inverted doc lists shared by several queries are prefetched by one
+ * MultiGet,stored field & docvalue are kept after first read,so documents
+ * matched by several queries are read once.
+ * Values are kept until max_bytes is reached,later ones are not cached.
+ * Not thread safe,queries of one batch run one by one.
+ */
+class BatchReadCache {
+ public:
+  struct Entry {
+    SearchStatus status;
+    std::string value;
+  };
+
+ private:
+  // Entry never move once added,so pointer returned is valid until
+  // cache is released.
+  std::unordered_map<std::string, Entry> values_;
+  size_t bytes_;
+  size_t max_bytes_;
+
+ public:
+  BatchReadCache(size_t max_bytes) : bytes_(0), max_bytes_(max_bytes) {}
+
+  virtual ~BatchReadCache() {}
+
+  // Return nullptr if key is not cached.
+  const Entry *Get(StorageColumnType column, const std::string &key);
+
+  // Return cached entry,value is taken over if it is newly added.
+  // Return nullptr and keep value if max_bytes is reached.
+  const Entry *Put(StorageColumnType column, const std::string &key,
+                   const SearchStatus &status, std::string &value);
+
+  size_t Size() { return this->values_.size(); }
+
+  size_t Bytes() { return this->bytes_; }
+
+ private:
+  static void EncodeKey(StorageColumnType column, const std::string &key,
+                        std::string &cache_key);
+};
+
+}  // namespace wwsearch
@@ -19,14 +19,17 @@
 #pragma once
 
 #include "bool_query.h"
+#include "doclist_cache.h"
 #include "weight.h"
 
 namespace wwsearch {
 
 class BooleanWeight : public Weight {
  private:
-  // Need to store values.
+  // Need to store values,not used if doc list is kept by BatchReadCache.
   std::vector<std::string> values_;
+  // Decoded doc list shared with DocListCache.
+  DocListCache::DocListPtr cached_doc_list_;
 
  public:
   BooleanWeight(BooleanQuery *query);
@@ -37,7 +40,16 @@ class BooleanWeight : public Weight {
 
   virtual BulkScorer *GetBulkScorer(SearchContext *context);
 
+  // Inverted key of query's term.
+  // Return false if value type is unknown.
+  static bool EncodeInvertedKey(SearchContext *context, BooleanQuery *query,
+                                std::string &key);
+
  private:
+  // Decode doc list to fixed size bytes and admit to cache if big enough.
+  void AdmitDocListCache(SearchContext *context, DocListCache *cache,
+                         const std::string &cache_key,
+                         const std::string &value);
 };
 
 }  // namespace wwsearch
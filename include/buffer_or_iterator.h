@@ -0,0 +1,70 @@
+/*
+ * Tencent is pleased to support the open source community by making wwsearch
+ * available.
+ *
+ * Copyright (C) 2018-present Tencent. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * https://opensource.org/licenses/Apache-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OF ANY KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+#pragma once
+
+#include <vector>
+#include "doc_iterator.h"
+
+namespace wwsearch {
+
+/* Notice : Get union set of many doc lists term-at-a-time.
+ * Every sub iterator added is drained at once into one buffer, the buffer
+ * is sorted in decrease order and deduplicated in FinishAddIterator.
+ * Compared with OrIterator, it costs no heap operation per doc, so it fits
+ * wide disjunctions(a lot of prefix terms) better.
+ * Sub iterators are not kept, caller can release them right after
+ * AddSubIterator.
+ * Match field id is kept per doc once sub iterators span several fields.
+ */
+class BufferOrIterator : public DocIdSetIterator {
+ private:
+  std::vector<DocumentID> docs_;
+  // field id of docs_[i],empty if all docs come from field_id_.
+  std::vector<int> fields_;
+  size_t pos_;
+  int field_id_;
+
+ public:
+  BufferOrIterator() : pos_(0), field_id_(-1) {}
+
+  virtual ~BufferOrIterator() {}
+
+  virtual DocumentID DocID() override;
+
+  virtual DocumentID NextDoc() override;
+
+  virtual DocumentID Advance(DocumentID target) override;
+
+  virtual CostType Cost() override;
+
+  virtual int FieldId() override {
+    return pos_ < fields_.size() ? fields_[pos_] : field_id_;
+  }
+
+  // Drain all docs of {iterator} from its current position.
+  void AddSubIterator(DocIdSetIterator* iterator);
+
+  void FinishAddIterator();
+
+  inline size_t Size() { return this->docs_.size(); }
+
+ private:
+  void FinishWithFields();
+};
+}  // namespace wwsearch
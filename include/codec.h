@@ -89,6 +89,9 @@ class Codec {
   virtual void EncodeSequenceMappingKey(
       const TableID& table, std::string& user_id,
       std::string& meta_key) = 0;  // store user's key mapping to docid
+  virtual void EncodeCompletionKey(
+      const TableID& table, const FieldID& field_id, const std::string& prefix,
+      std::string& meta_key) = 0;  // store top terms of prefix
 
   // Dictionary
 
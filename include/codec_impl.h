@@ -112,6 +112,11 @@ class CodecImpl : public Codec {
                                         std::string& user_id,
                                         std::string& meta_key) override;
 
+  virtual void EncodeCompletionKey(const TableID& table,
+                                   const FieldID& field_id,
+                                   const std::string& prefix,
+                                   std::string& meta_key) override;
+
  private:
 };
 
@@ -18,6 +18,10 @@
 
 #pragma once
 
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include "aggregation.h"
 #include "collector.h"
 #include "filter.h"
 #include "post_scorer.h"
@@ -27,6 +31,20 @@
 namespace wwsearch {
 class Searcher;
 class SearchContext;
+class ThreadPool;
+
+// Docvalue read of one batch,run on thread pool or by waiter if it is not
+// started yet.
+struct DocValueFetch {
+  std::vector<Document *> docs;
+  std::vector<SearchStatus> status;
+  SearchStatus ret;
+  uint64_t consume_us{0};
+  std::mutex mutex;
+  std::condition_variable cond;
+  bool started{false};
+  bool done{false};
+};
 
 using PriorityQueue =
     std::priority_queue<Document *, std::vector<Document *>, Sorter>;
@@ -51,6 +69,11 @@ using ScorePriorityQueue =
  * 4. Sort : use PriorityQueue to sort the doc list.
  *    PriorityQueue with a Sorter compare function, support compare base on
  *    numeric.
+ *
+ * If prefetch pool is set,docvalue of full batch is read on it while next
+ * batch is collected,and batch is filtered when next one is full.
+ * Batch size shrinks to what is needed for remaining top n by filter pass
+ * rate when documents are collected in final order.
  */
 class TopNCollector : public Collector {
  private:
@@ -76,6 +99,19 @@ class TopNCollector : public Collector {
   bool quick_top_n;
   wwsearch::SearchTracer *tracer_;
   uint32_t *get_match_total_cnt_;
+  // sorter is same as doc id order,see IndexConfig::SetIndexSortField.
+  bool index_sorted_;
+  // Only collect documents sorted after it if set.
+  Document *search_after_;
+  // Optional,add documents passed filter to them.
+  std::vector<Aggregation *> *aggregations_;
+  // Optional,read docvalue of batch ahead on it.
+  ThreadPool *prefetch_pool_;
+  std::shared_ptr<DocValueFetch> pending_fetch_;
+  // docs of current batch,see NextBatchSize.
+  size_t batch_size_;
+  uint64_t filter_checked_docs_;
+  uint64_t filter_passed_docs_;
 
  public:
   TopNCollector(
@@ -106,20 +142,36 @@ class TopNCollector : public Collector {
         min_match_filter_num_(min_match_filter_num),
         quick_top_n(false),
         tracer_(tracer),
-        get_match_total_cnt_(get_match_total_cnt) {
+        get_match_total_cnt_(get_match_total_cnt),
+        index_sorted_(false),
+        search_after_(nullptr),
+        aggregations_(nullptr),
+        prefetch_pool_(nullptr),
+        batch_size_(0),
+        filter_checked_docs_(0),
+        filter_passed_docs_(0) {
     if (nullptr != filter) {
       if (0 == min_match_filter_num_ ||
           min_match_filter_num_ > filter->size()) {
         min_match_filter_num_ = filter->size();
       }
     }
-    quick_top_n = (nullptr == sorter);
+    index_sorted_ = MatchIndexSort(search_context->GetConfig(), sorter);
+    quick_top_n = (nullptr == sorter) || index_sorted_;
     if (use_score_strategy_) {
       assert(max_score_doc_num_ >= top_n_);
     }
+    batch_size_ = NextBatchSize();
   }
 
   virtual ~TopNCollector() {
+    if (nullptr != pending_fetch_) {
+      CancelFetch(pending_fetch_.get());
+      for (auto document : pending_fetch_->docs) {
+        delete document;
+      }
+      pending_fetch_.reset();
+    }
     for (auto document : buffer_docs_) {
       if (nullptr != document) delete document;
     }
@@ -142,9 +194,63 @@ class TopNCollector : public Collector {
 
   virtual void GetAndClearMatchDocs(std::list<DocumentID> &docs) override;
 
+  // All match documents will be read & added to aggregations.
+  void SetAggregations(std::vector<Aggregation *> *aggregations) {
+    this->aggregations_ = aggregations;
+  }
+
+  // Read docvalue of batches ahead on pool.Pool must not be waited by
+  // caller,eg ParallelCollect partitions.
+  void SetPrefetchPool(ThreadPool *pool) { this->prefetch_pool_ = pool; }
+
+  // Docs to collect before current batch is purged,see NextBatchSize.
+  size_t RemainingBatchDocs() {
+    if (this->batch_size_ <= this->buffer_docs_.size()) return 1;
+    return this->batch_size_ - this->buffer_docs_.size();
+  }
+
+  // If documents in descending doc id are sorted by sorter already.
+  static bool MatchIndexSort(IndexConfig *config,
+                             std::vector<SortCondition *> *sorter);
+
+  // Drop documents not sorted after search_after,which must hold the fields
+  // of sorter.Caller owns it.
+  void SetSearchAfter(Document *search_after) {
+    this->search_after_ = search_after;
+  }
+
+  // Documents read to check filter,the rest are dropped by
+  // MaxInnerPurgeDocsTotalLimit.
+  uint32_t PurgedDocsCount() { return this->inner_purge_total_docs_count_; }
+
+  // Move top n documents out without offset applied,caller owns them.
+  // Used to merge collectors of query partitions.
+  void GetAndClearTopDocs(std::vector<Document *> &docs);
+
+  // Push documents already filtered by other collectors,take the ownership.
+  void MergeTopDocs(std::vector<Document *> &docs);
+
  private:
   inline void InnerPurge();
 
+  // Filter & sort buffer_docs_ with docvalue read by ret & status.
+  void PurgeFetched(SearchStatus &ret, std::vector<SearchStatus> &status);
+
+  // Filter previous prefetched batch and start read of current one.
+  void PrefetchPurge();
+
+  // Filter prefetched batch if any.
+  void FinishFetch();
+
+  static void RunFetch(DocValueFetch *fetch, Searcher *searcher,
+                       const TableID &table, SearchContext *search_context);
+
+  void WaitFetch(DocValueFetch *fetch);
+
+  static void CancelFetch(DocValueFetch *fetch);
+
+  size_t NextBatchSize();
+
   bool MatchFilter(Document *document);
 
   void HandleScorePriorityQueue();
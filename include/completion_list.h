@@ -0,0 +1,86 @@
+/*
+ * Tencent is pleased to support the open source community by making wwsearch
+ * available.
+ *
+ * Copyright (C) 2018-present Tencent. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * https://opensource.org/licenses/Apache-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OF ANY KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+#pragma once
+
+#include "header.h"
+#include "search_slice.h"
+
+namespace wwsearch {
+
+/* Notice : Top terms of one prefix by weight(doc frequency),value of one
+ * completion key.Writer merges per batch weight deltas and merge operator
+ * folds them with Space-Saving:when list is full,a new term replaces the
+ * lightest one,inherits its weight and records it as error,so heavy terms
+ * are never lost and no read before write is needed.Terms rank by weight
+ * minus error,the part surely owned by the term,so inherited weight is
+ * never reported and deletes of an untracked term can be dropped.Entry is
+ * dropped once weight is not above error.
+ * Format : varint capacity,varint count,
+ *          [varint size,term,fixed64 weight,fixed64 error]
+ */
+class CompletionList {
+ public:
+  typedef std::pair<std::string, int64_t> Entry;
+
+ private:
+  struct Item {
+    std::string term;
+    int64_t weight;
+    int64_t error;
+  };
+
+  uint32_t capacity_;
+  std::vector<Item> items_;
+
+ public:
+  CompletionList(uint32_t capacity = 0) : capacity_(capacity) {}
+
+  virtual ~CompletionList() {}
+
+  // Apply weight delta of term.
+  void Add(const std::string &term, int64_t delta) { Add(term, delta, 0); }
+
+  // Record raw delta without folding,used by writer to build operand.
+  void Append(const std::string &term, int64_t delta) {
+    items_.push_back(Item{term, delta, 0});
+  }
+
+  // Apply all entries of other.
+  void Merge(const CompletionList &other);
+
+  // Heaviest k terms by weight minus error,ties by term.
+  void TopK(size_t k, std::vector<Entry> &entries) const;
+
+  uint32_t Capacity() const { return capacity_; }
+
+  size_t Size() const { return items_.size(); }
+
+  void SerializeToBytes(std::string &value) const;
+
+  bool Deserialize(const Slice &value);
+
+  // Merge operand value into existing value,existing may be nullptr.
+  static void MergeValue(const Slice *existing, const Slice &value,
+                         std::string &new_value);
+
+ private:
+  void Add(const std::string &term, int64_t delta, int64_t error);
+};
+
+}  // namespace wwsearch
@@ -0,0 +1,87 @@
+/*
+ * Tencent is pleased to support the open source community by making wwsearch
+ * available.
+ *
+ * Copyright (C) 2018-present Tencent. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * https://opensource.org/licenses/Apache-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OF ANY KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace wwsearch {
+
+/* Notice : Sharded LRU cache of decoded(fixed size) doc lists.
+ * Key is inverted key plus table's write version(see TableVersion) read
+ * before the query snapshot,so entries of old version are never hit and
+ * just age out.
+ * Cached doc list is immutable and shared by readers through shared_ptr,
+ * eviction does not affect running queries.
+ * Only doc lists with at least min_doc_list_size docs are admitted,
+ * small lists are cheap to decode.
+ */
+class DocListCache {
+ public:
+  typedef std::shared_ptr<const std::string> DocListPtr;
+
+ private:
+  struct Shard {
+    std::mutex mutex;
+    // front is the most recently used.
+    std::list<std::pair<std::string, DocListPtr>> lru;
+    std::unordered_map<std::string,
+                       std::list<std::pair<std::string, DocListPtr>>::iterator>
+        index;
+    size_t usage_bytes{0};
+  };
+
+  std::vector<std::unique_ptr<Shard>> shards_;
+  size_t shard_capacity_bytes_;
+  uint32_t min_doc_list_size_;
+
+  std::atomic<uint64_t> hits_;
+  std::atomic<uint64_t> misses_;
+
+ public:
+  DocListCache(size_t capacity_bytes, uint32_t min_doc_list_size = 1024,
+               size_t shard_num = 16);
+
+  virtual ~DocListCache() {}
+
+  // Return nullptr if not found.
+  DocListPtr Get(const std::string &key);
+
+  void Put(const std::string &key, const DocListPtr &doc_list);
+
+  inline uint32_t MinDocListSize() { return min_doc_list_size_; }
+
+  inline uint64_t Hits() { return hits_.load(); }
+
+  inline uint64_t Misses() { return misses_.load(); }
+
+  size_t UsageBytes();
+
+ private:
+  Shard *GetShard(const std::string &key);
+
+  static size_t Charge(const std::string &key, const DocListPtr &doc_list);
+};
+
+}  // namespace wwsearch
@@ -28,6 +28,8 @@ namespace wwsearch {
 
 using TermFlagPairList = std::map<std::string, unsigned char>;
 using TermFlagPairListPtr = std::unique_ptr<TermFlagPairList>;
+// inverted key -> doc frequency delta of one write batch.
+using DocFreqDeltaList = std::map<std::string, int64_t>;
 
 class DocumentWriter {
  private:
@@ -76,6 +78,11 @@ class DocumentWriter {
   SearchStatus DropTable(const TableID& table, std::string* store_buffer,
                          SearchTracer* tracer = nullptr);
 
+  // Every flush of table data goes here,so caches of table are bypassed
+  // while it is in flight and invalidated after.
+  SearchStatus FlushWriteBuffer(const TableID& table,
+                                WriteBuffer* write_buffer);
+
  private:
   SearchStatus WriteStoredField(const TableID& table,
                                 std::vector<DocumentUpdater*>& documents,
@@ -87,9 +94,11 @@ class DocumentWriter {
                              WriteBuffer& write_buffer,
                              SearchTracer* tracer = nullptr);
 
+  // doc_freq_deltas is filled if not nullptr.
   SearchStatus WriteInvertedIndex(const TableID& table,
                                   std::vector<DocumentUpdater*>& documents,
                                   WriteBuffer& write_buffer,
+                                  DocFreqDeltaList* doc_freq_deltas,
                                   SearchTracer* tracer = nullptr);
 
   SearchStatus WriteTableMeta(const TableID& table,
@@ -98,10 +107,15 @@ class DocumentWriter {
                               SearchTracer* tracer = nullptr);
 
   SearchStatus WriteDictionaryMeta(const TableID& table,
-                                   std::vector<DocumentUpdater*>& documents,
+                                   const DocFreqDeltaList& doc_freq_deltas,
                                    WriteBuffer& write_buffer,
                                    SearchTracer* tracer = nullptr);
 
+  SearchStatus WriteCompletion(const TableID& table,
+                               std::vector<DocumentUpdater*>& documents,
+                               WriteBuffer& write_buffer,
+                               SearchTracer* tracer = nullptr);
+
   SearchStatus RunTokenizer(std::vector<DocumentUpdater*>& documents,
                             SearchTracer* tracer = nullptr);
 
@@ -110,6 +124,13 @@ class DocumentWriter {
   void MergeDocvalue(Document& old_docvalue_document,
                      Document* new_docvalue_document);
 
+  void AddNumericTrieTerms(IndexField* field, const std::string& term,
+                           unsigned char flag, TermFlagPairList& term_match);
+
+  // Docs of item not in old doc list yet,old doc list is read from db.
+  uint32_t CountNewDocs(const InvertIndexItem& item,
+                        const std::string& old_doc_list);
+
   SearchStatus WriteStoreFieldForDropTable(const TableID& table,
                                            WriteBuffer& write_buffer,
                                            SearchTracer* tracer = nullptr);
@@ -19,6 +19,7 @@
 #pragma once
 #include <algorithm>
 #include <sstream>
+#include "coding.h"
 #include "header.h"
 #include "index_field.h"
 #include "logger.h"
@@ -45,6 +46,10 @@ class Filter {
   virtual std::string PrintReadableStr() {
     return std::string("not implementation");
   };
+
+  // Canonical key of filter,used by query result cache.
+  // Return false if filter could not be encoded.
+  virtual bool EncodeKey(std::string &key) { return false; }
   // If field match uint32 or uint64 field.
   static bool CheckFieldTypeNumeric(const IndexField &field) {
     if (field.FieldType() == kUint32IndexField ||
@@ -61,6 +66,21 @@ class Filter {
     return false;
   };
 
+ protected:
+  // type tag and field's value.
+  void EncodeFieldKey(uint8_t tag, std::string &key) {
+    AppendFixed8(key, tag);
+    AppendFixed8(key, field_.ID());
+    AppendFixed8(key, field_.FieldType());
+    AppendFixed64(key, field_.NumericValue());
+    AppendFixed32(key, field_.StringValue().size());
+    key.append(field_.StringValue());
+    AppendFixed32(key, field_.NumericList().size());
+    for (auto value : field_.NumericList()) {
+      AppendFixed64(key, value);
+    }
+  }
+
  private:
 };
 
@@ -84,6 +104,11 @@ class EqualFilter : public Filter {
     return false;
   }
 
+  virtual bool EncodeKey(std::string &key) override {
+    EncodeFieldKey(1, key);
+    return true;
+  }
+
   virtual std::string PrintReadableStr() {
     char buffer[64];
     snprintf(buffer, sizeof(buffer), "field=%u equal [%llu]", field_.ID(),
@@ -113,6 +138,11 @@ class NotEqualFilter : public Filter {
     // type not match,skip
     return false;
   }
+  virtual bool EncodeKey(std::string &key) override {
+    EncodeFieldKey(2, key);
+    return true;
+  }
+
   virtual std::string PrintReadableStr() {
     char buffer[64];
     snprintf(buffer, sizeof(buffer), "field=%u not equal [%llu]", field_.ID(),
@@ -134,6 +164,10 @@ class RangeFilter : public Filter {
 
   virtual ~RangeFilter() {}
 
+  inline uint64_t Begin() const { return begin_; }
+
+  inline uint64_t End() const { return end_; }
+
   virtual bool Match(const IndexField *field) override {
     // if no field stored,just filter it,because we do not know
     if (nullptr == field) return false;
@@ -146,6 +180,13 @@ class RangeFilter : public Filter {
     return field->NumericValue() >= begin_ && field->NumericValue() <= end_;
   }
 
+  virtual bool EncodeKey(std::string &key) override {
+    EncodeFieldKey(3, key);
+    AppendFixed64(key, begin_);
+    AppendFixed64(key, end_);
+    return true;
+  }
+
   virtual std::string PrintReadableStr() {
     char buffer[64];
     snprintf(buffer, sizeof(buffer), "field=%u in range [%llu,%llu]",
@@ -179,6 +220,11 @@ class InFilter : public Filter {
     }
   }
 
+  virtual bool EncodeKey(std::string &key) override {
+    EncodeFieldKey(4, key);
+    return true;
+  }
+
   virtual std::string PrintReadableStr() {
     char buffer[64];
     snprintf(buffer, sizeof(buffer), "field=%u in [%s]", field_.ID(),
@@ -209,6 +255,11 @@ class NotInFilter : public Filter {
     }
   }
 
+  virtual bool EncodeKey(std::string &key) override {
+    EncodeFieldKey(5, key);
+    return true;
+  }
+
   virtual std::string PrintReadableStr() {
     char buffer[64];
     snprintf(buffer, sizeof(buffer), "field=%u not in [%s]", field_.ID(),
@@ -239,6 +290,11 @@ class InNumericListFilter : public Filter {
     return iter != numeric_list.end();
   }
 
+  virtual bool EncodeKey(std::string &key) override {
+    EncodeFieldKey(6, key);
+    return true;
+  }
+
   virtual std::string PrintReadableStr() {
     char buffer[128];
     snprintf(buffer, sizeof(buffer), "field=%u in [%s]", field_.ID(),
@@ -269,6 +325,11 @@ class NotInNumericListFilter : public Filter {
     return iter == numeric_list.end();
   }
 
+  virtual bool EncodeKey(std::string &key) override {
+    EncodeFieldKey(7, key);
+    return true;
+  }
+
   virtual std::string PrintReadableStr() {
     char buffer[128];
     snprintf(buffer, sizeof(buffer), "field=%u in [%s]", field_.ID(),
@@ -312,6 +373,18 @@ class MatchStringListFilter : public Filter {
     return revert_ ? !match : match;
   }
 
+  virtual bool EncodeKey(std::string &key) override {
+    EncodeFieldKey(8, key);
+    AppendFixed8(key, revert_);
+    AppendFixed32(key, min_should_match_filter_values_num_);
+    AppendFixed32(key, string_value_list_.size());
+    for (const auto &value : string_value_list_) {
+      AppendFixed32(key, value.size());
+      key.append(value);
+    }
+    return true;
+  }
+
   virtual std::string PrintReadableStr() {
     char buffer[128];
     snprintf(buffer, sizeof(buffer), "MatchStringListFilter: size=%u revert=%d",
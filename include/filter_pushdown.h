@@ -0,0 +1,66 @@
+/*
+ * Tencent is pleased to support the open source community by making wwsearch
+ * available.
+ *
+ * Copyright (C) 2018-present Tencent. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * https://opensource.org/licenses/Apache-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OF ANY KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+#pragma once
+
+#include "filter.h"
+#include "index_config.h"
+#include "query.h"
+
+namespace wwsearch {
+
+/* Notice : Push post filters down to inverted index lookups.
+ * Only works when all filters must be matched and filter's field is
+ * flagged with InvertIndex(as document's field indexed).
+ * 1. Numeric EqualFilter -> BooleanQuery.
+ * 2. InNumericListFilter -> OrQuery of BooleanQuery.
+ * 3. RangeFilter with NumericTrie flag -> NumericRangeQuery.
+ * 4. String EqualFilter -> BooleanQuery,but filter still need to check,
+ *    because tokenizer may lower case the indexed term.
+ * Pushed queries are AND with user's query,filters fully answered by
+ * inverted index will not read docvalue any more.
+ */
+class FilterPushdown {
+ private:
+  IndexConfig *config_;
+  // queries created by us,release in destructor.
+  std::vector<Query *> queries_;
+  std::vector<Filter *> remain_filter_;
+  size_t pushed_filter_num_;
+
+ public:
+  FilterPushdown(IndexConfig *config)
+      : config_(config), pushed_filter_num_(0) {}
+
+  virtual ~FilterPushdown();
+
+  // Return query need to execute,filter will be set to remain filters.
+  // If nothing could push down,query and filter are not changed.
+  Query *Plan(Query *query, std::vector<Filter *> *&filter,
+              uint32_t min_match_filter_num);
+
+  inline size_t PushedFilterNum() { return pushed_filter_num_; }
+
+ private:
+  // Return nullptr if filter can not push down.
+  Query *BuildQuery(Filter *filter, bool &answered);
+
+  Query *BuildTermQuery(const IndexField &field, uint64_t value);
+};
+
+}  // namespace wwsearch
@@ -0,0 +1,57 @@
+/*
+ * Tencent is pleased to support the open source community by making wwsearch
+ * available.
+ *
+ * Copyright (C) 2018-present Tencent. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * https://opensource.org/licenses/Apache-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OF ANY KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+#pragma once
+
+#include "header.h"
+#include "query.h"
+
+namespace wwsearch {
+
+/* Notice : Match terms of field within max_edits(0-2) Levenshtein distance
+ * of term.If more than max_expansion_terms terms match,the closest ones
+ * are kept.
+ */
+class FuzzyQuery : public Query {
+ private:
+  FieldID field_id_;
+  std::string match_term_;
+  uint32_t max_edits_;
+  uint32_t max_expansion_terms_;
+
+ public:
+  FuzzyQuery(FieldID field_id, const std::string &term, uint32_t max_edits = 2,
+             uint32_t max_expansion_terms = 50);
+
+  virtual ~FuzzyQuery();
+
+  virtual Weight *CreateWeight(SearchContext *context, bool needs_scores,
+                               double boost) override;
+
+  FieldID GetFieldID() { return this->field_id_; }
+
+  inline std::string &MatchTerm() { return this->match_term_; }
+
+  inline uint32_t MaxEdits() { return this->max_edits_; }
+
+  inline uint32_t MaxExpansionTerms() { return this->max_expansion_terms_; }
+
+ private:
+};
+
+}  // namespace wwsearch
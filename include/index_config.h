@@ -19,7 +19,11 @@
 #pragma once
 
 #include "codec.h"
+#include "doclist_cache.h"
 #include "header.h"
+#include "query_result_cache.h"
+#include "table_version.h"
+#include "thread_pool.h"
 #include "tokenizer.h"
 #include "virtual_db.h"
 
@@ -30,12 +34,52 @@ class IndexConfig {
   Codec* codec_;
   VirtualDB* vdb_;
   Tokenizer* tokenizer_;
+  // Optional,cache DoQuery result if set.User should release it.
+  QueryResultCache* query_result_cache_;
+  // Optional,cache decoded doc list if set.User should release it.
+  DocListCache* doclist_cache_;
+  // Optional,run partitions of one query in parallel if set.User should
+  // release it.
+  ThreadPool* query_thread_pool_;
+  // Optional,run stages of asynchronous queries if set.Must not be same as
+  // query_thread_pool_.User should release it.
+  ThreadPool* search_executor_;
+  // Write version of tables,used by caches.
+  TableVersion table_version_;
   uint32_t min_suffix_build_len_{5};         // min suffix build len.Default:5
   uint32_t max_suffix_term_size_{64};        // max suffix term size
   uint32_t max_write_batch_size_{19922944};  // max write batch size limit: 19MB
   uint32_t max_inner_purge_batch_docs_count_{
       10000};  // max batch docs in InnerPurge
   uint32_t max_inner_purge_docs_total_limit_{50000};
+  // max doc lists merged by heap in one disjunction,the others will be
+  // unioned term-at-a-time into one buffer.
+  uint32_t max_or_heap_iterators_{64};
+  // OrQuery whose sub doc lists cost more than it will be unioned
+  // term-at-a-time too. Union is computed at once,so it only pays off
+  // when most of docs will be visited.
+  uint32_t min_or_term_at_a_time_cost_{1000000};
+  // bits per level of numeric trie terms.
+  // Attention : must not change once numeric trie terms have been written.
+  uint32_t numeric_trie_precision_step_{8};
+  // Field whose value never decrease as doc id increase in all tables,so
+  // descending doc id is descending order of it.-1 means not set.
+  // Attention : user must assign doc id in this order.
+  int32_t index_sort_field_{-1};
+  // max partitions of one query's doc list.
+  uint32_t query_parallelism_{4};
+  // min docs in one partition,small query runs in one thread.
+  uint32_t min_parallel_partition_docs_{10000};
+  // keep doc frequency of terms in kDictionaryColumn,term expansion walks
+  // it instead of inverted index.
+  // Attention : enable it on new index only.
+  bool term_dictionary_{false};
+  // terms kept per prefix of completion field.
+  uint32_t completion_top_k_{10};
+  // prefixes longer than it(in code points) are not indexed.
+  uint32_t max_completion_prefix_len_{8};
+  // max bytes of values kept by one batch of queries.Default:64MB
+  uint32_t max_batch_read_cache_bytes_{64 << 20};
   SearchLogLevel log_level_;
 
  public:
@@ -55,6 +99,28 @@ class IndexConfig {
 
   Tokenizer* GetTokenizer();
 
+  // Set nullptr to disable query result cache.
+  bool SetQueryResultCache(QueryResultCache* query_result_cache);
+
+  QueryResultCache* GetQueryResultCache();
+
+  // Set nullptr to disable doc list cache.
+  bool SetDocListCache(DocListCache* doclist_cache);
+
+  DocListCache* GetDocListCache();
+
+  // Set nullptr to disable intra query parallelism.
+  bool SetQueryThreadPool(ThreadPool* query_thread_pool);
+
+  ThreadPool* GetQueryThreadPool();
+
+  // Set nullptr to disable Searcher::DoQueryAsync.
+  bool SetSearchExecutor(ThreadPool* search_executor);
+
+  ThreadPool* GetSearchExecutor();
+
+  TableVersion* GetTableVersion() { return &this->table_version_; }
+
   bool SetMinSuffixBuildLen(uint32_t min_len) {
     this->min_suffix_build_len_ = min_len;
   }
@@ -91,6 +157,87 @@ class IndexConfig {
     return this->max_inner_purge_docs_total_limit_;
   }
 
+  bool SetMaxOrHeapIterators(uint32_t max_or_heap_iterators) {
+    this->max_or_heap_iterators_ = max_or_heap_iterators;
+    return true;
+  }
+
+  uint32_t GetMaxOrHeapIterators() { return this->max_or_heap_iterators_; }
+
+  bool SetMinOrTermAtATimeCost(uint32_t min_or_term_at_a_time_cost) {
+    this->min_or_term_at_a_time_cost_ = min_or_term_at_a_time_cost;
+    return true;
+  }
+
+  uint32_t GetMinOrTermAtATimeCost() {
+    return this->min_or_term_at_a_time_cost_;
+  }
+
+  bool SetNumericTriePrecisionStep(uint32_t numeric_trie_precision_step) {
+    this->numeric_trie_precision_step_ = numeric_trie_precision_step;
+    return true;
+  }
+
+  uint32_t GetNumericTriePrecisionStep() {
+    return this->numeric_trie_precision_step_;
+  }
+
+  // Set -1 to disable.
+  bool SetIndexSortField(int32_t index_sort_field) {
+    this->index_sort_field_ = index_sort_field;
+    return true;
+  }
+
+  int32_t GetIndexSortField() { return this->index_sort_field_; }
+
+  bool SetQueryParallelism(uint32_t query_parallelism) {
+    this->query_parallelism_ = query_parallelism;
+    return true;
+  }
+
+  uint32_t GetQueryParallelism() { return this->query_parallelism_; }
+
+  bool SetMinParallelPartitionDocs(uint32_t min_parallel_partition_docs) {
+    this->min_parallel_partition_docs_ = min_parallel_partition_docs;
+    return true;
+  }
+
+  uint32_t GetMinParallelPartitionDocs() {
+    return this->min_parallel_partition_docs_;
+  }
+
+  bool SetTermDictionary(bool term_dictionary) {
+    this->term_dictionary_ = term_dictionary;
+    return true;
+  }
+
+  bool UseTermDictionary() { return this->term_dictionary_; }
+
+  bool SetCompletionTopK(uint32_t completion_top_k) {
+    this->completion_top_k_ = completion_top_k;
+    return true;
+  }
+
+  uint32_t GetCompletionTopK() { return this->completion_top_k_; }
+
+  bool SetMaxCompletionPrefixLen(uint32_t max_completion_prefix_len) {
+    this->max_completion_prefix_len_ = max_completion_prefix_len;
+    return true;
+  }
+
+  uint32_t GetMaxCompletionPrefixLen() {
+    return this->max_completion_prefix_len_;
+  }
+
+  bool SetMaxBatchReadCacheBytes(uint32_t max_batch_read_cache_bytes) {
+    this->max_batch_read_cache_bytes_ = max_batch_read_cache_bytes;
+    return true;
+  }
+
+  uint32_t GetMaxBatchReadCacheBytes() {
+    return this->max_batch_read_cache_bytes_;
+  }
+
   bool SetLogLevel(SearchLogLevel log_level) {
     this->log_level_ = log_level;
     return true;
@@ -83,7 +83,9 @@ enum kIndexFieldFlag {
   kDocValueFieldFlag = 1 << 2,
   kSuffixBuildFlag = 1 << 3,
   kInvertIndexFieldFlag = 1 << 4,
-  kNotStoreInvertTermFieldFlag = 1 << 5
+  kNotStoreInvertTermFieldFlag = 1 << 5,
+  kNumericTrieFieldFlag = 1 << 6,
+  kCompletionFieldFlag = 1 << 7
 };
 
 class IndexFieldFlag {
@@ -114,6 +116,12 @@ class IndexFieldFlag {
   void SetNotStoreInvertTerm();
   bool NotStoreInvertTerm() const;
 
+  void SetNumericTrie();
+  bool NumericTrie() const;
+
+  void SetCompletion();
+  bool Completion() const;
+
   inline unsigned char Flag() const { return this->flag_; }
 
   inline void SetFlag(unsigned char flag) { this->flag_ = flag; }
@@ -57,7 +57,7 @@ class IndexWriter {
   // Add document while the old document is not exist in database.
   // DO NOT have same DocumentID in documents.Each DocumentUpdater have its own
   // status code return. NOTE,if store_buffer not null,record will flush to this
-  // buffer but not flush to db.
+  // buffer but not flush to db.Flush it by FlushStoreBuffer.
   bool AddDocuments(const TableID &table,
                     std::vector<DocumentUpdater *> &documents,
                     std::string *store_buffer = nullptr,
@@ -97,6 +97,8 @@ class IndexWriter {
                                SearchTracer *tracer = nullptr);
 
   // Ingest InvertIndex only write inverted index but not write other data.
+  // Docs indexed by term already are not counted in its doc frequency
+  // again,but docs of store_buffer not flushed yet are not seen.
   bool IngestInvertIndex(const TableID &table, InvertIndexItemList &indices,
                          std::string *store_buffer,
                          SearchTracer *tracer = nullptr);
@@ -117,6 +119,11 @@ class IndexWriter {
   bool DropTable(const TableID &table, std::string *store_buffer,
                  SearchTracer *tracer = nullptr);
 
+  // Flush records returned by store_buffer of table to db,cached results of
+  // table are invalidated like other writes.
+  SearchStatus FlushStoreBuffer(const TableID &table,
+                                const std::string &store_buffer);
+
   // For certain
   // delete data
   SearchStatus DeleteTableData(TableID &table,
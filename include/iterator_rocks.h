@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include <memory>
 #include "rocksdb/iterator.h"
 #include "search_iterator.h"
 
@@ -29,10 +30,20 @@ namespace wwsearch {
 class IteratorRocks : public Iterator {
  private:
   rocksdb::Iterator* iterator_;
+  // rocksdb only keep pointer of upper bound,so we hold it here.
+  std::unique_ptr<std::string> upper_bound_;
+  std::unique_ptr<rocksdb::Slice> upper_bound_slice_;
 
  public:
   IteratorRocks(rocksdb::Iterator* iterator) : iterator_(iterator) {}
 
+  IteratorRocks(rocksdb::Iterator* iterator,
+                std::unique_ptr<std::string>&& upper_bound,
+                std::unique_ptr<rocksdb::Slice>&& upper_bound_slice)
+      : iterator_(iterator),
+        upper_bound_(std::move(upper_bound)),
+        upper_bound_slice_(std::move(upper_bound_slice)) {}
+
   virtual ~IteratorRocks() {
     if (iterator_ != nullptr) {
       delete iterator_;
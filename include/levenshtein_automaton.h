@@ -0,0 +1,72 @@
+/*
+ * Tencent is pleased to support the open source community by making wwsearch
+ * available.
+ *
+ * Copyright (C) 2018-present Tencent. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * https://opensource.org/licenses/Apache-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OF ANY KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+#pragma once
+
+#include "header.h"
+
+namespace wwsearch {
+
+/* Notice : Levenshtein automaton of one term over unicode code points.
+ * State is a row of edit distances between consumed prefix and each prefix
+ * of term,so it is built in O(n) per char without DFA construction.
+ * Accept() intersects it with sorted terms:a term is either accepted or
+ * the smallest greater string which may be accepted is returned,so caller
+ * seeks dictionary iterator there instead of scanning.
+ */
+class LevenshteinAutomaton {
+ public:
+  typedef std::vector<uint32_t> State;
+
+ private:
+  std::vector<uint32_t> term_;
+  // distinct code points of term,ascending.
+  std::vector<uint32_t> alphabet_;
+  uint32_t max_edits_;
+
+ public:
+  LevenshteinAutomaton(const std::string &term, uint32_t max_edits);
+
+  virtual ~LevenshteinAutomaton() {}
+
+  void Start(State &state);
+
+  void Step(const State &state, uint32_t code_point, State &next);
+
+  // Some suffix may reach an accept state.
+  bool CanMatch(const State &state);
+
+  // Edit distance of consumed string and term.
+  uint32_t Distance(const State &state) { return state.back(); }
+
+  // Return true if term is accepted.Otherwise seek is smallest string
+  // greater than term which may be accepted,empty if none.
+  bool Accept(const std::string &term, uint32_t &distance, std::string &seek);
+
+  static bool DecodeUTF8(const std::string &str,
+                         std::vector<uint32_t> &code_points);
+
+  static void EncodeUTF8(const std::vector<uint32_t> &code_points,
+                         size_t size, std::string &str);
+
+ private:
+  // Smallest code point greater than after which keeps state alive.
+  bool NextCodePoint(const State &state, uint32_t after, uint32_t &next);
+};
+
+}  // namespace wwsearch
@@ -22,15 +22,24 @@
 namespace wwsearch {
 
 /* Notice : Get intersection doc list from vector<DocIdSetIterator*>
+ * Sub iterators are sorted by cost,the cheapest one leads and others
+ * advance to its candidate.
  */
 class MergeIterator : public DocIdSetIterator {
  private:
   std::vector<DocIdSetIterator*> sub_iterator_;
+  // field id come from the first added iterator.
+  DocIdSetIterator* first_iterator_;
   DocumentID curr_;
   int field_id_;
+  bool sorted_;
 
  public:
-  MergeIterator() : curr_(NO_MORE_DOCS), field_id_(-1) {}
+  MergeIterator()
+      : first_iterator_(nullptr),
+        curr_(NO_MORE_DOCS),
+        field_id_(-1),
+        sorted_(false) {}
 
   virtual ~MergeIterator() {}
 
@@ -45,11 +54,13 @@ class MergeIterator : public DocIdSetIterator {
   virtual int FieldId() override { return field_id_; }
 
   void AddSubIterator(DocIdSetIterator* iterator) {
+    if (nullptr == first_iterator_) first_iterator_ = iterator;
     this->sub_iterator_.push_back(iterator);
+    sorted_ = false;
   }
 
   // must call after AddSubIterator to reach init state.
-  inline void FinishAddIterator() { curr_ = Advance(MAX_DOCID); }
+  void FinishAddIterator();
 
  private:
   DocumentID InnderNextDoc(bool use_advance = false,
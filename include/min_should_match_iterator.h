@@ -0,0 +1,67 @@
+/*
+ * Tencent is pleased to support the open source community by making wwsearch
+ * available.
+ *
+ * Copyright (C) 2018-present Tencent. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * https://opensource.org/licenses/Apache-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OF ANY KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+#pragma once
+#include "doc_iterator.h"
+
+namespace wwsearch {
+
+/* Notice : Documents in at least min_should_match of sub iterators.
+ * Next match is never greater than k-th greatest head of sub iterators
+ * (k = min_should_match),so iterators before it are advanced to it
+ * directly,documents which can not reach k matches are skipped.
+ */
+class MinShouldMatchIterator : public DocIdSetIterator {
+ private:
+  std::vector<DocIdSetIterator*> sub_iterator_;
+  std::vector<DocumentID> heads_;
+  uint32_t min_should_match_;
+  DocumentID curr_;
+  int field_id_;
+
+ public:
+  MinShouldMatchIterator(uint32_t min_should_match)
+      : min_should_match_(min_should_match == 0 ? 1 : min_should_match),
+        curr_(NO_MORE_DOCS),
+        field_id_(-1) {}
+
+  virtual ~MinShouldMatchIterator() {}
+
+  virtual DocumentID DocID() override;
+
+  virtual DocumentID NextDoc() override;
+
+  virtual DocumentID Advance(DocumentID target) override;
+
+  // upper bound,every match is in one of n-k+1 cheapest sub iterators.
+  virtual CostType Cost() override;
+
+  virtual int FieldId() override { return field_id_; }
+
+  void AddSubIterator(DocIdSetIterator* iterator) {
+    this->sub_iterator_.push_back(iterator);
+  }
+
+  // must call after AddSubIterator to reach init state.
+  void FinishAddIterator();
+
+ private:
+  // Next match from current heads of sub iterators.
+  DocumentID NextMatch();
+};
+}  // namespace wwsearch
@@ -0,0 +1,50 @@
+/*
+ * Tencent is pleased to support the open source community by making wwsearch
+ * available.
+ *
+ * Copyright (C) 2018-present Tencent. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * https://opensource.org/licenses/Apache-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OF ANY KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+#pragma once
+
+#include "query.h"
+
+namespace wwsearch {
+
+/* Notice : Match documents which match at least min_should_match sub
+ * queries,eg 2 of 5 keywords.min_should_match 1 is same as OrQuery.
+ */
+class MinShouldMatchQuery : public Query {
+ private:
+  std::vector<Query*> sub_query_;  // we do not need release outer query
+  uint32_t min_should_match_;
+
+ public:
+  MinShouldMatchQuery(uint32_t min_should_match)
+      : min_should_match_(min_should_match) {}
+
+  virtual ~MinShouldMatchQuery() {}
+
+  virtual Weight* CreateWeight(SearchContext* context, bool needs_scores,
+                               double boost) override;
+
+  void AddQuery(Query* query) { sub_query_.push_back(query); }
+
+  inline const std::vector<Query*>& SubQuery() { return sub_query_; }
+
+  inline uint32_t MinShouldMatch() { return min_should_match_; }
+
+ private:
+};
+}  // namespace wwsearch
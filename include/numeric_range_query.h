@@ -0,0 +1,71 @@
+/*
+ * Tencent is pleased to support the open source community by making wwsearch
+ * available.
+ *
+ * Copyright (C) 2018-present Tencent. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * https://opensource.org/licenses/Apache-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OF ANY KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+#pragma once
+
+#include "header.h"
+#include "index_field.h"
+#include "query.h"
+
+namespace wwsearch {
+
+/* Notice : Match numeric field value in [lower,upper].
+ * If field is indexed with numeric trie flag, range will be split into a
+ * bounded set of multi precision terms and read by one MultiGet.
+ * Otherwise set trie_indexed to false, the full precision terms in range
+ * will be scanned one by one.
+ */
+class NumericRangeQuery : public Query {
+ private:
+  FieldID field_id_;
+  kIndexFieldType value_type_;
+  uint64_t lower_;
+  uint64_t upper_;
+  bool trie_indexed_;
+  uint32_t max_expansion_terms_;
+
+ public:
+  NumericRangeQuery(FieldID field_id, uint32_t lower, uint32_t upper,
+                    bool trie_indexed = true,
+                    uint32_t max_expansion_terms = 100000);
+
+  NumericRangeQuery(FieldID field_id, uint64_t lower, uint64_t upper,
+                    bool trie_indexed = true,
+                    uint32_t max_expansion_terms = 100000);
+
+  virtual ~NumericRangeQuery();
+
+  virtual Weight *CreateWeight(SearchContext *context, bool needs_scores,
+                               double boost) override;
+
+  FieldID GetFieldID() { return this->field_id_; }
+
+  inline kIndexFieldType ValueType() { return this->value_type_; }
+
+  inline uint64_t Lower() { return this->lower_; }
+
+  inline uint64_t Upper() { return this->upper_; }
+
+  inline bool TrieIndexed() { return this->trie_indexed_; }
+
+  inline uint32_t MaxExpansionTerms() { return this->max_expansion_terms_; }
+
+ private:
+};
+
+}  // namespace wwsearch
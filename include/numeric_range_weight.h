@@ -0,0 +1,48 @@
+/*
+ * Tencent is pleased to support the open source community by making wwsearch
+ * available.
+ *
+ * Copyright (C) 2018-present Tencent. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * https://opensource.org/licenses/Apache-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OF ANY KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+#pragma once
+
+#include "numeric_range_query.h"
+#include "term_expansion.h"
+#include "weight.h"
+
+namespace wwsearch {
+
+class NumericRangeWeight : public Weight {
+ private:
+  TermExpansion expansion_;
+
+ public:
+  NumericRangeWeight(NumericRangeQuery *query);
+
+  virtual ~NumericRangeWeight();
+
+  virtual Scorer *GetScorer(SearchContext *context);
+
+  virtual BulkScorer *GetBulkScorer(SearchContext *context);
+
+ private:
+  // Read doc lists of trie terms by one MultiGet.
+  SearchStatus ReadTrieTerms(SearchContext *context, NumericRangeQuery *query);
+
+  // Scan full precision terms in range.
+  SearchStatus ScanTerms(SearchContext *context, NumericRangeQuery *query);
+};
+
+}  // namespace wwsearch
@@ -0,0 +1,59 @@
+/*
+ * Tencent is pleased to support the open source community by making wwsearch
+ * available.
+ *
+ * Copyright (C) 2018-present Tencent. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * https://opensource.org/licenses/Apache-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OF ANY KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+#pragma once
+
+#include <string>
+#include <vector>
+#include "header.h"
+
+namespace wwsearch {
+
+/* Notice : Multi precision terms of numeric field, used by NumericRangeQuery.
+ * Full precision term(shift = 0) is the normal numeric term,big-end
+ * fixed32/fixed64.
+ * Lower precision term is : shift(1B) + (value >> shift)(fixed32/fixed64),
+ * shift is multiple of precision step.
+ * Precision step must not be changed once numeric trie terms have been
+ * written.
+ */
+class NumericTrie {
+ public:
+  // bits : 32 or 64
+  static void EncodeTerm(uint64_t value, uint32_t shift, uint32_t bits,
+                         std::string& term);
+
+  // Build lower precision terms from one full precision term.
+  // Return false if {term} is not a fixed32/fixed64 numeric term.
+  static bool BuildLowerPrecisionTerms(const std::string& term,
+                                       uint32_t precision_step,
+                                       std::vector<std::string>& terms);
+
+  // Split [lower,upper] into minimal terms of different precision.
+  // Return false if more than {max_terms} terms are needed.
+  static bool SplitRange(uint64_t lower, uint64_t upper, uint32_t bits,
+                         uint32_t precision_step, size_t max_terms,
+                         std::vector<std::string>& terms);
+
+ private:
+  static bool AddRange(uint64_t min, uint64_t max, uint32_t shift,
+                       uint32_t bits, size_t max_terms,
+                       std::vector<std::string>& terms);
+};
+
+}  // namespace wwsearch
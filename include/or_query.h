@@ -35,6 +35,8 @@ class OrQuery : public Query {
 
   void AddQuery(Query* query) { sub_query_.push_back(query); }
 
+  inline const std::vector<Query*>& SubQuery() { return sub_query_; }
+
  private:
 };
 }  // namespace wwsearch
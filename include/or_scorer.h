@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include "buffer_or_iterator.h"
 #include "or_iterator.h"
 #include "or_weight.h"
 #include "scorer.h"
@@ -28,9 +29,16 @@ class OrScorer : public Scorer {
  private:
   std::vector<Scorer *> sub_scorer_;
   OrIterator iterator_;
+  // term-at-a-time mode for wide disjunctions.
+  bool term_at_a_time_;
+  bool buffer_ready_;
+  BufferOrIterator buffer_iterator_;
 
  public:
-  OrScorer(OrWeight *weight) : Scorer(weight, "OrScorer") {}
+  OrScorer(OrWeight *weight)
+      : Scorer(weight, "OrScorer"),
+        term_at_a_time_(false),
+        buffer_ready_(false) {}
 
   virtual ~OrScorer() {
     // our response to delete scorer
@@ -48,6 +56,13 @@ class OrScorer : public Scorer {
     this->iterator_.AddSubIterator(&(s->Iterator()));
   }
 
+  // Sub scorers will be unioned into one buffer instead of heap.
+  inline void UseTermAtATime() { this->term_at_a_time_ = true; }
+
+  inline bool TermAtATime() { return this->term_at_a_time_; }
+
+  inline size_t SubScorerSize() { return this->sub_scorer_.size(); }
+
  private:
 };
 }  // namespace wwsearch
@@ -29,10 +29,12 @@ class PrefixQuery : public Query {
   FieldID field_id_;
   std::string match_term_;
   uint32_t max_doc_list_size_;
+  uint32_t max_expansion_terms_;
 
  public:
   PrefixQuery(FieldID field_id, const std::string &term,
-              uint32_t max_doc_list_size = 1000000);
+              uint32_t max_doc_list_size = 1000000,
+              uint32_t max_expansion_terms = 100000);
 
   virtual ~PrefixQuery();
 
@@ -45,6 +47,8 @@ class PrefixQuery : public Query {
 
   inline uint32_t MaxDocListSize() { return this->max_doc_list_size_; }
 
+  inline uint32_t MaxExpansionTerms() { return this->max_expansion_terms_; }
+
  private:
 };
 
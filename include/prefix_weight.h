@@ -18,18 +18,15 @@
 
 #pragma once
 
-#include "or_iterator.h"
 #include "prefix_query.h"
+#include "term_expansion.h"
 #include "weight.h"
 
 namespace wwsearch {
 
 class PrefixWeight : public Weight {
  private:
-  // because we must store values.so put it here.
-  std::vector<std::string> values_;
-  std::vector<DocListReaderCodec *> iterators;
-  OrIterator *or_iterator;
+  TermExpansion expansion_;
   Codec *codec_;  // outer reference.
 
  public:
@@ -42,6 +39,15 @@ class PrefixWeight : public Weight {
   virtual BulkScorer *GetBulkScorer(SearchContext *context);
 
  private:
+  // Walk doc lists of matched terms in kInvertedIndexColumn.
+  void ExpandByInvertedIndex(SearchContext *context);
+
+  // Walk kDictionaryColumn,then read doc lists of matched terms only.
+  void ExpandByDictionary(SearchContext *context);
+
+  // Set status if MaxDocListSize reached.
+  bool ReachDocListSizeLimit(SearchContext *context,
+                             uint32_t total_doc_list_size);
 };
 
 }  // namespace wwsearch
@@ -0,0 +1,86 @@
+/*
+ * Tencent is pleased to support the open source community by making wwsearch
+ * available.
+ *
+ * Copyright (C) 2018-present Tencent. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * https://opensource.org/licenses/Apache-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OF ANY KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+#include "storage_type.h"
+
+namespace wwsearch {
+
+/* Notice : LRU cache of Searcher::DoQuery's result.
+ * Every entry is tagged with table's write version(see TableVersion) read
+ * before query starts,so stale entry will never be served.
+ * Memory is bounded by capacity_bytes.
+ */
+class QueryResultCache {
+ private:
+  struct Entry {
+    std::string key;
+    uint64_t version;
+    std::vector<DocumentID> docs;
+    uint32_t match_total_cnt;
+    size_t charge;
+  };
+
+  std::mutex mutex_;
+  // front is the most recently used.
+  std::list<Entry> lru_;
+  std::unordered_map<std::string, std::list<Entry>::iterator> index_;
+  size_t capacity_bytes_;
+  size_t usage_bytes_;
+
+  std::atomic<uint64_t> hits_;
+  std::atomic<uint64_t> misses_;
+
+ public:
+  QueryResultCache(size_t capacity_bytes);
+
+  virtual ~QueryResultCache() {}
+
+  // If hit,docs will be inserted at front and match_total_cnt will be
+  // added,same as DoQuery.
+  bool Get(const TableID &table, const std::string &key, uint64_t version,
+           std::list<DocumentID> &docs, uint32_t *match_total_cnt);
+
+  void Put(const TableID &table, const std::string &key, uint64_t version,
+           const std::list<DocumentID> &docs, uint32_t match_total_cnt);
+
+  void Clear();
+
+  inline uint64_t Hits() { return hits_.load(); }
+
+  inline uint64_t Misses() { return misses_.load(); }
+
+  size_t UsageBytes();
+
+  size_t Size();
+
+ private:
+  std::string EntryKey(const TableID &table, const std::string &key);
+
+  // Need hold mutex_.
+  void Erase(std::list<Entry>::iterator iter);
+};
+
+}  // namespace wwsearch
@@ -0,0 +1,84 @@
+/*
+ * Tencent is pleased to support the open source community by making wwsearch
+ * available.
+ *
+ * Copyright (C) 2018-present Tencent. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * https://opensource.org/licenses/Apache-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OF ANY KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+#pragma once
+
+#include <map>
+#include "query.h"
+#include "search_context.h"
+
+namespace wwsearch {
+
+class PrefixQuery;
+
+/* Notice : Rewrite query tree before CreateWeight.
+ * 1. Flatten nested AndQuery/OrQuery.
+ * 2. Dedupe same sub query in AndQuery/OrQuery.
+ * 3. PrefixQuery which only match one term -> BooleanQuery.
+ * 4. Reorder AndQuery's sub query by estimated cost,cheap and empty one
+ *    first,so AndWeight could stop reading others once one is empty.
+ *    The first sub query is kept first unless some one is empty,because
+ *    match field id come from it.Term queries are ordered by doc frequency
+ *    if term dictionary is used.
+ * User's query is never changed,new queries are owned by rewriter.
+ */
+class QueryRewriter {
+ private:
+  struct RewriteResult {
+    Query *query;
+    std::string key;
+    uint32_t cost;
+  };
+
+  SearchContext *context_;
+  // queries created by us,release in destructor.
+  std::vector<Query *> queries_;
+  // rewritten query,include original and new one.
+  std::map<Query *, RewriteResult> rewritten_;
+
+ public:
+  QueryRewriter(SearchContext *context) : context_(context) {}
+
+  virtual ~QueryRewriter();
+
+  Query *Rewrite(Query *query);
+
+  // Canonical key of query tree,sub query order is kept.
+  // Return false if some query could not be encoded.
+  static bool EncodeQueryKey(Query *query, std::string &key);
+
+ private:
+  static bool EncodeLeafKey(Query *query, std::string &key);
+
+  static bool EncodeQueryList(const std::vector<Query *> &sub_query,
+                              std::string &key);
+
+  // key : canonical key of query,empty means unknown query.
+  // cost : estimated cost rank,smaller is cheaper.
+  Query *InnerRewrite(Query *query, std::string &key, uint32_t &cost);
+
+  Query *RewriteBoolean(bool is_and, const std::vector<Query *> &sub_query,
+                        std::string &key, uint32_t &cost);
+
+  Query *RewritePrefix(PrefixQuery *query, std::string &key, uint32_t &cost);
+
+  // Doc frequency of term query from term dictionary,UINT64_MAX if unknown.
+  uint64_t EstimateDocFreq(Query *query);
+};
+
+}  // namespace wwsearch
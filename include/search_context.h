@@ -18,7 +18,9 @@
 
 #pragma once
 
+#include "batch_read_cache.h"
 #include "index_config.h"
+#include "search_deadline.h"
 #include "search_status.h"
 #include "virtual_db.h"
 
@@ -31,11 +33,28 @@ class SearchContext {
   VirtualDBSnapshot *snapshot_;
   IndexConfig *config_;
   SearchStatus status_;
+  // Optional,reads shared by a batch of queries.
+  BatchReadCache *batch_read_cache_;
+  // Optional,checked by Interrupted().
+  SearchDeadline *deadline_;
+  uint32_t deadline_checks_;
+  bool interrupted_;
+  // Version of table read before snapshot,caches keyed by version are not
+  // used if it is kNoVersion.
+  uint64_t read_version_;
 
  public:
   SearchContext(TableID table, VirtualDB *vdb, VirtualDBSnapshot *snapshot,
                 IndexConfig *config)
-      : table_(table), vdb_(vdb), snapshot_(snapshot), config_(config) {}
+      : table_(table),
+        vdb_(vdb),
+        snapshot_(snapshot),
+        config_(config),
+        batch_read_cache_(nullptr),
+        deadline_(nullptr),
+        deadline_checks_(0),
+        interrupted_(false),
+        read_version_(TableVersion::kNoVersion) {}
 
   virtual ~SearchContext() {}
 
@@ -49,6 +68,37 @@ class SearchContext {
 
   inline SearchStatus &Status() { return this->status_; }
 
+  inline void SetBatchReadCache(BatchReadCache *batch_read_cache) {
+    this->batch_read_cache_ = batch_read_cache;
+  }
+
+  inline BatchReadCache *GetBatchReadCache() {
+    return this->batch_read_cache_;
+  }
+
+  inline void SetDeadline(SearchDeadline *deadline) {
+    this->deadline_ = deadline;
+  }
+
+  inline SearchDeadline *GetDeadline() { return this->deadline_; }
+
+  inline void SetReadVersion(uint64_t read_version) {
+    this->read_version_ = read_version;
+  }
+
+  inline uint64_t ReadVersion() { return this->read_version_; }
+
+  // Cheap enough for every document,clock is read once per 256 calls.
+  // Once true,status is set to timeout/cancelled and it keeps true.
+  inline bool Interrupted() {
+    if (nullptr == deadline_) return false;
+    if (interrupted_) return true;
+    if (deadline_->Cancelled() || 0 == (deadline_checks_++ & 0xff)) {
+      interrupted_ = !deadline_->Check(status_);
+    }
+    return interrupted_;
+  }
+
  private:
 };
 
@@ -0,0 +1,57 @@
+/*
+ * Tencent is pleased to support the open source community by making wwsearch
+ * available.
+ *
+ * Copyright (C) 2018-present Tencent. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * https://opensource.org/licenses/Apache-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OF ANY KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include "search_status.h"
+
+namespace wwsearch {
+
+/* Notice:
+ * Deadline & cancellation token of one query,shared by all threads which
+ * run the query.Query stops at next check point after timeout or Cancel(),
+ * and returns kQueryTimeoutStatus/kQueryCancelledStatus with documents
+ * collected so far.
+ */
+class SearchDeadline {
+ private:
+  // 0 means no timeout.
+  uint64_t deadline_us_;
+  std::atomic<bool> cancelled_;
+
+ public:
+  // Timeout starts from now.
+  explicit SearchDeadline(uint64_t timeout_us = 0);
+
+  virtual ~SearchDeadline() {}
+
+  // Thread safe.
+  void Cancel();
+
+  bool Cancelled() const;
+
+  bool Expired() const;
+
+  // Set status if query should stop,return false then.
+  bool Check(SearchStatus &status) const;
+
+ private:
+};
+
+}  // namespace wwsearch
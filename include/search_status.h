@@ -36,6 +36,9 @@ enum kSearchStatusCode {
   kScorerErrorStatus = -18536,
   kDocumentTooLargeStatus = 18537,
   kReachMaxDocListSizeLimit = 18538,
+  kReachMaxExpansionTermsLimit = 18539,
+  kQueryTimeoutStatus = 18540,
+  kQueryCancelledStatus = 18541,
 };
 
 class SearchStatus {
@@ -60,6 +63,11 @@ class SearchStatus {
 
   bool ReachMaxDocListSizeLimit();
 
+  bool ReachMaxExpansionTermsLimit();
+
+  // Query is interrupted by SearchDeadline.
+  bool Interrupted();
+
   bool OK();
 
   int GetCode() const;
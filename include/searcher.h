@@ -18,16 +18,62 @@
 
 #pragma once
 
+#include "aggregation.h"
+#include "async_query.h"
 #include "filter.h"
 #include "index_config.h"
 #include "post_scorer.h"
 #include "query.h"
+#include "search_deadline.h"
 #include "search_status.h"
 #include "sorter.h"
 #include "tracer.h"
 
 namespace wwsearch {
 
+class BooleanQuery;
+
+// Estimated total hits of a query,see Searcher::DoQuery.
+struct HitEstimate {
+  // estimated match documents count.
+  uint64_t total;
+  // 95% confidence interval is total +- error_bound.
+  uint64_t error_bound;
+  // true if all candidates were filtered,total is exact then.
+  bool exact;
+
+  HitEstimate() : total(0), error_bound(0), exact(false) {}
+};
+
+// One query of a batch,see Searcher::DoQueries.
+struct SearchRequest {
+  // input
+  Query *query;
+  size_t offset;
+  size_t limit;
+  std::vector<Filter *> *filter;
+  std::vector<SortCondition *> *sorter;
+  uint32_t min_match_filter_num;
+  bool need_match_total_cnt;
+
+  // output
+  SearchStatus status;
+  std::list<DocumentID> docs;
+  uint32_t match_total_cnt;
+
+  SearchRequest(Query *query, size_t offset, size_t limit,
+                std::vector<Filter *> *filter = nullptr,
+                std::vector<SortCondition *> *sorter = nullptr)
+      : query(query),
+        offset(offset),
+        limit(limit),
+        filter(filter),
+        sorter(sorter),
+        min_match_filter_num(0),
+        need_match_total_cnt(false),
+        match_total_cnt(0) {}
+};
+
 /* Notice : Query interface for user.
  * input : Query, filters, sorters
  * output : doc list
@@ -48,6 +94,11 @@ class Searcher {
   virtual ~Searcher() {}
 
   // If min_match_filter_num = 0,all filter must be match.
+  // If hit_estimate is set,all candidates are walked and the filter pass
+  // rate of documents read before MaxInnerPurgeDocsTotalLimit is
+  // extrapolated to the rest.
+  // If deadline is set,query stops after timeout or cancel and returns
+  // kQueryTimeoutStatus/kQueryCancelledStatus with docs collected so far.
   SearchStatus DoQuery(
       const TableID &table, Query &query, size_t offset, size_t limit,
       std::vector<Filter *> *filter, std::vector<SortCondition *> *sorter,
@@ -56,8 +107,74 @@ class Searcher {
           nullptr,
       size_t max_score_doc_num = SIZE_MAX, uint32_t min_match_filter_num = 0,
       wwsearch::SearchTracer *tracer = nullptr,
+      uint32_t *get_match_total_cnt = nullptr,
+      HitEstimate *hit_estimate = nullptr,
+      SearchDeadline *deadline = nullptr);
+
+  // Non-blocking DoQuery,stages run on IndexConfig's search executor and
+  // callback is called on it with status & docs.query,filter,sorter and
+  // deadline must be alive until callback.
+  // Return error if search executor is not set,callback is not called then.
+  SearchStatus DoQueryAsync(const TableID &table, Query &query, size_t offset,
+                            size_t limit, std::vector<Filter *> *filter,
+                            std::vector<SortCondition *> *sorter,
+                            SearchCallback callback,
+                            uint32_t min_match_filter_num = 0,
+                            SearchDeadline *deadline = nullptr);
+
+  // Deep pagination by cursor instead of offset.
+  // cursor is empty for first page.After return it is the position of last
+  // returned document,pass it back to get next page.It is cleared when
+  // there are no more documents.Cursor is only valid with same query,
+  // filter and sorter.
+  SearchStatus DoQueryAfter(const TableID &table, Query &query, size_t limit,
+                            std::vector<Filter *> *filter,
+                            std::vector<SortCondition *> *sorter,
+                            std::string &cursor, std::list<DocumentID> &docs,
+                            uint32_t min_match_filter_num = 0,
+                            wwsearch::SearchTracer *tracer = nullptr);
+
+  // Facet counts,counts[i] is number of match documents of query which
+  // also match facets[i],a term of facet field.
+  // Doc list of query is intersected with doc list of each term,no docvalue
+  // or stored field is read.
+  // If deadline is set,scan stops after timeout or cancel and returns
+  // kQueryTimeoutStatus/kQueryCancelledStatus with partial counts.
+  SearchStatus DoFacet(const TableID &table, Query &query,
+                       std::vector<BooleanQuery *> &facets,
+                       std::vector<uint64_t> &counts,
+                       wwsearch::SearchTracer *tracer = nullptr,
+                       SearchDeadline *deadline = nullptr);
+
+  // Count match documents without reading docvalue or stored field.
+  // Count comes from iterator tree,or doc list length of single term query.
+  // If some filters could not be pushed down to inverted index,it falls
+  // back to collector which reads docvalue.
+  SearchStatus DoCount(const TableID &table, Query &query,
+                       std::vector<Filter *> *filter, uint64_t &count,
+                       uint32_t min_match_filter_num = 0,
+                       wwsearch::SearchTracer *tracer = nullptr);
+
+  // Search several tables with one snapshot,docs is the global top n of
+  // all tables,ordered by sorter like single table DoQuery.
+  // Tables run concurrently on query thread pool if it is set.
+  SearchStatus DoQuery(
+      const std::vector<TableID> &tables, Query &query, size_t offset,
+      size_t limit, std::vector<Filter *> *filter,
+      std::vector<SortCondition *> *sorter,
+      std::list<std::pair<TableID, DocumentID>> &docs,
+      uint32_t min_match_filter_num = 0,
+      wwsearch::SearchTracer *tracer = nullptr,
       uint32_t *get_match_total_cnt = nullptr);
 
+  // Run a batch of queries on one table with one snapshot.
+  // Doc lists of term queries are fetched by one MultiGet,documents matched
+  // by several queries read docvalue once.Each request has its own status
+  // and docs.
+  SearchStatus DoQueries(const TableID &table,
+                         std::vector<SearchRequest> &requests,
+                         wwsearch::SearchTracer *tracer = nullptr);
+
   // GetDocument
   // If success,status is ok,and document will fill with content.
   SearchStatus GetStoredFields(const TableID &table,
@@ -69,13 +186,28 @@ class Searcher {
   SearchStatus GetDocValue(const TableID &table, std::vector<Document *> &docs,
                            std::vector<SearchStatus> &status,
                            SearchContext *context);
+  // Suggest at most top_k terms of field starting with prefix,heaviest
+  // first,by one point lookup of completion index,doc lists are not read.
+  // Field must be written with IndexFieldFlag::SetCompletion.Prefix longer
+  // than GetMaxCompletionPrefixLen is answered from its indexed prefix.
+  SearchStatus Complete(
+      const TableID &table, FieldID field_id, const std::string &prefix,
+      uint32_t top_k,
+      std::vector<std::pair<std::string, uint64_t>> &suggestions);
+
   // Support post filter?
   SearchStatus DoPostFilter() { return SearchStatus(); }
 
   // Support sort
 
-  // Support aggeration
-  SearchStatus DoAggregation() { return SearchStatus(); }
+  // Aggregate match documents by docvalue,only buckets of aggregations are
+  // returned.At most MaxInnerPurgeDocsTotalLimit documents are aggregated,
+  // same as match count of DoQuery.
+  SearchStatus DoAggregation(const TableID &table, Query &query,
+                             std::vector<Filter *> *filter,
+                             std::vector<Aggregation *> &aggregations,
+                             uint32_t min_match_filter_num = 0,
+                             wwsearch::SearchTracer *tracer = nullptr);
 
   // use for get all entity
   // only get kDB kPaxosDataMetaColumn column
@@ -99,6 +231,48 @@ class Searcher {
                                                       1024 /*18MB*/);
 
  private:
+  // Collect top n documents of planned query in one table,used by multi
+  // tables & batch DoQuery.top_docs is ordered from best to worst.
+  SearchStatus CollectTopDocs(SearchContext *context, Query *query,
+                              size_t top_n, std::vector<Filter *> *filter,
+                              std::vector<SortCondition *> *sorter,
+                              uint32_t min_match_filter_num,
+                              wwsearch::SearchTracer *tracer,
+                              uint32_t *get_match_total_cnt,
+                              std::vector<Document *> &top_docs,
+                              Document *search_after = nullptr);
+
+  // Collect doc list of scorer by doc id ranges on query thread pool.
+  SearchStatus ParallelCollect(
+      SearchContext *context, Scorer *scorer, size_t offset, size_t limit,
+      std::vector<Filter *> *filter, std::vector<SortCondition *> *sorter,
+      uint32_t min_match_filter_num, wwsearch::SearchTracer *tracer,
+      uint32_t *get_match_total_cnt, std::list<DocumentID> &docs);
+
+  // Cursor is sort fields & id of last document of page.
+  static bool EncodeCursor(Document *document,
+                           std::vector<SortCondition *> *sorter,
+                           std::string &cursor);
+
+  static bool DecodeCursor(const std::string &cursor,
+                           std::vector<SortCondition *> *sorter,
+                           Document &document);
+
+  static void EstimateHits(uint64_t candidate_docs, uint64_t purged_docs,
+                           uint64_t match_docs, HitEstimate *hit_estimate);
+
+  // Run run(0..num-1),1..num-1 are also submitted to pool.Caller runs
+  // every part not yet started,so it is safe from a worker of pool.
+  static void RunParts(ThreadPool *pool, size_t num,
+                       const std::function<void(size_t)> &run);
+
+  // Return false if request could not be cached.
+  bool BuildQueryCacheKey(Query &query, size_t offset, size_t limit,
+                          std::vector<Filter *> *filter,
+                          std::vector<SortCondition *> *sorter,
+                          uint32_t min_match_filter_num,
+                          bool need_match_total_cnt, std::string &key);
+
   // 0->stored field
   // 1->doc value
   SearchStatus InnerGetFields(int mode, const TableID &table,
@@ -18,6 +18,7 @@
 
 #pragma once
 
+#include "coding.h"
 #include "index_field.h"
 
 namespace wwsearch {
@@ -40,6 +41,19 @@ class SortCondition {
 
   inline FieldID GetID() { return this->field_id_; }
 
+  inline kSortConditionType SortType() const { return this->sort_type_; }
+
+  // Canonical key of sort condition,used by query result cache.
+  // Return false if it could not be encoded.
+  virtual bool EncodeKey(std::string &key) const { return false; }
+
+ protected:
+  void EncodeConditionKey(uint8_t tag, std::string &key) const {
+    AppendFixed8(key, tag);
+    AppendFixed8(key, field_id_);
+    AppendFixed8(key, sort_type_);
+  }
+
  private:
 };
 
@@ -58,6 +72,11 @@ class NumericSortCondition : public SortCondition {
     return (kSortConditionDesc == sort_type_) ? ret : !ret;
   }
 
+  virtual bool EncodeKey(std::string &key) const override {
+    EncodeConditionKey(1, key);
+    return true;
+  }
+
   // have field first
   // document id big first
   bool InnerGreater(const DocumentID &d1, const IndexField *f1,
@@ -101,6 +120,11 @@ class StringSortCondition : public SortCondition {
     return (kSortConditionDesc == sort_type_) ? ret : !ret;
   }
 
+  virtual bool EncodeKey(std::string &key) const override {
+    EncodeConditionKey(2, key);
+    return true;
+  }
+
   // have field first
   // document id big first
   bool InnerGreater(const DocumentID &d1, const IndexField *f1,
@@ -151,7 +175,7 @@ class Sorter {
       auto rhs_field = rhs->FindField(sc->GetID());
       auto c1 = sc->Greater(lhs->ID(), lhs_field, rhs->ID(), rhs_field);
       auto c2 = sc->Greater(rhs->ID(), rhs_field, lhs->ID(), lhs_field);
-      if (c1 && c2) {
+      if (c1 == c2) {
         continue;
       } else if (c1) {
         return true;
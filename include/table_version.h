@@ -0,0 +1,61 @@
+/*
+ * Tencent is pleased to support the open source community by making wwsearch
+ * available.
+ *
+ * Copyright (C) 2018-present Tencent. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * https://opensource.org/licenses/Apache-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OF ANY KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include "storage_type.h"
+
+namespace wwsearch {
+
+/* Notice : Write version of tables,used to invalidate caches.
+ * Versions are kept in fixed number of hashed slots,tables share one slot
+ * just invalidate each other more often.
+ * Every flush to a table is wrapped by BeginWrite/EndWrite,both bump the
+ * version.Get returns kNoVersion while a write is in flight,so a reader
+ * never pairs data of the write with a version before it.
+ */
+class TableVersion {
+ private:
+  std::unique_ptr<std::atomic<uint64_t>[]> versions_;
+  // writes in flight of slot.
+  std::unique_ptr<std::atomic<uint32_t>[]> writing_;
+  size_t slots_;
+
+ public:
+  // Caches must not be used with it.
+  static const uint64_t kNoVersion = UINT64_MAX;
+
+  TableVersion(size_t slots = 4096);
+
+  virtual ~TableVersion() {}
+
+  // Must read before taking snapshot.
+  uint64_t Get(const TableID &table);
+
+  void BeginWrite(const TableID &table);
+
+  // Call even if flush fail,data may be partly written.
+  void EndWrite(const TableID &table);
+
+ private:
+  size_t Slot(const TableID &table);
+};
+
+}  // namespace wwsearch
@@ -0,0 +1,86 @@
+/*
+ * Tencent is pleased to support the open source community by making wwsearch
+ * available.
+ *
+ * Copyright (C) 2018-present Tencent. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * https://opensource.org/licenses/Apache-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OF ANY KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+#pragma once
+
+#include "header.h"
+#include "search_slice.h"
+#include "search_status.h"
+#include "storage_type.h"
+
+namespace wwsearch {
+
+class SearchContext;
+class Iterator;
+
+/* Notice : Terms of one field in one table with document frequency.
+ * kDictionaryColumn uses the same key as inverted index and its value is a
+ * fixed64 signed delta,writer merges +1/-1 per changed doc and the column's
+ * merge operator sums them,so no read before write.Keys are sorted and
+ * RocksDB block restart encoding already shares common prefix of adjacent
+ * terms,dictionary is walked without reading any doc list block.
+ * Terms whose frequency drop to 0 are skipped.
+ * Attention : frequency counts live docs of write path,enable it on new
+ * index only,or terms written before lack from dictionary.
+ */
+class TermDictionary {
+ private:
+  SearchContext *context_;
+  std::string field_key_;  // key prefix of field
+  Iterator *iterator_;
+  std::string term_;
+  uint64_t doc_freq_;
+
+ public:
+  TermDictionary(SearchContext *context, FieldID field);
+
+  virtual ~TermDictionary();
+
+  // Position at first term >= term.
+  void Seek(const std::string &term);
+
+  bool Valid() { return nullptr != iterator_; }
+
+  void Next();
+
+  const std::string &Term() { return term_; }
+
+  uint64_t DocFreq() { return doc_freq_; }
+
+  // Read doc lists of terms from inverted index,value is empty if missing.
+  SearchStatus ReadDocLists(const std::vector<std::string> &terms,
+                            std::vector<std::string> &values);
+
+  // Document frequency of one term without reading its doc list.
+  static SearchStatus GetDocFreq(SearchContext *context, FieldID field,
+                                 const std::string &term, uint64_t &doc_freq);
+
+  static void EncodeDocFreq(int64_t delta, std::string &value);
+
+  static int64_t DecodeDocFreq(const Slice &value);
+
+  // Sum existing value and delta value,existing may be nullptr.
+  static void MergeDocFreq(const Slice *existing, const Slice &value,
+                           std::string &new_value);
+
+ private:
+  // Skip dead terms and stop at end of field.
+  void FindLive();
+};
+
+}  // namespace wwsearch
@@ -0,0 +1,69 @@
+/*
+ * Tencent is pleased to support the open source community by making wwsearch
+ * available.
+ *
+ * Copyright (C) 2018-present Tencent. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * https://opensource.org/licenses/Apache-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OF ANY KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+#pragma once
+
+#include "buffer_or_iterator.h"
+#include "or_iterator.h"
+#include "search_context.h"
+
+namespace wwsearch {
+
+/* Notice : Union of doc lists of terms matched by a multi term query,such
+ * as prefix,fuzzy and wildcard.The first GetMaxOrHeapIterators doc lists
+ * are kept and merged by heap,others are decoded at once into a
+ * BufferOrIterator,so wide expansion does not hold every doc list.
+ * Usage : Init,AddDocList or TakeDocList per term,then Finish.
+ */
+class TermExpansion {
+ private:
+  std::vector<std::string> values_;
+  std::vector<DocListReaderCodec *> iterators_;
+  BufferOrIterator *buffer_iterator_;
+  OrIterator *or_iterator_;
+  Codec *codec_;  // outer reference.
+  FieldID field_id_;
+  size_t max_heap_terms_;
+
+ public:
+  TermExpansion()
+      : buffer_iterator_(nullptr),
+        or_iterator_(nullptr),
+        codec_(nullptr),
+        field_id_(0),
+        max_heap_terms_(0) {}
+
+  virtual ~TermExpansion();
+
+  void Init(SearchContext *context, FieldID field_id);
+
+  // Copy doc list of one term.
+  void AddDocList(const Slice &value);
+
+  // Same as AddDocList,but take over value,value is left empty.
+  void TakeDocList(std::string &value);
+
+  // Build union of all doc lists added,owned by this.
+  // Note: may be empty because no one term match.
+  OrIterator *Finish();
+
+ private:
+  void AddToBuffer(const char *data, size_t size);
+};
+
+}  // namespace wwsearch
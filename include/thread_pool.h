@@ -0,0 +1,56 @@
+/*
+ * Tencent is pleased to support the open source community by making wwsearch
+ * available.
+ *
+ * Copyright (C) 2018-present Tencent. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * https://opensource.org/licenses/Apache-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OF ANY KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+#pragma once
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include "header.h"
+
+namespace wwsearch {
+
+/* Notice : Fixed size worker pool.
+ * Used by Searcher to run partitions of one query in parallel.
+ * Tasks are run in submit order,destructor waits all submitted tasks.
+ */
+class ThreadPool {
+ private:
+  std::mutex mutex_;
+  std::condition_variable cond_;
+  std::deque<std::function<void()>> tasks_;
+  std::vector<std::thread> workers_;
+  bool stop_;
+
+ public:
+  ThreadPool(size_t thread_num);
+
+  virtual ~ThreadPool();
+
+  ThreadPool(const ThreadPool &) = delete;
+  ThreadPool &operator=(const ThreadPool &) = delete;
+
+  void Submit(std::function<void()> task);
+
+  size_t ThreadNum() { return this->workers_.size(); }
+
+ private:
+  void Run();
+};
+
+}  // namespace wwsearch
@@ -81,6 +81,13 @@ class SearchTracer {
 
   uint64_t Get(TracerType type) { return tracer_cnt_list_[type]; }
 
+  // Add all counters of other,used to gather tracers of worker threads.
+  void Merge(const SearchTracer& other) {
+    for (const auto& kv : other.tracer_cnt_list_) {
+      Add(kv.first, kv.second);
+    }
+  }
+
   void Clear() { tracer_cnt_list_.clear(); }
 
  private:
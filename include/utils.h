@@ -34,6 +34,14 @@ void SplitString(const std::string& full, const std::string& delim,
                  std::vector<std::string>* result);
 std::string TrimString(const std::string& str, const std::string& trim = " ");
 
+// Return the smallest key greater than all keys start with {prefix}.
+// Return empty string if there is no such key(all bytes are 0xff).
+std::string PrefixSuccessor(const std::string& prefix);
+
+// Return true if data[0,size) starts with {prefix}.Scan bounded by
+// PrefixSuccessor checks keys by it,as the bound is empty for all 0xff.
+bool HasPrefix(const char* data, size_t size, const std::string& prefix);
+
 template <class Container>
 std::string JoinContainerToString(const Container& c,
                                   const std::string& joiner) {
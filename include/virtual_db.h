@@ -103,6 +103,10 @@ class VirtualDBWriteOption {
 class VirtualDBReadOption {
  public:
   VirtualDBSnapshot* snapshot_;
+  // Exclusive upper bound of iterator,empty means no bound.
+  // Iterator become invalid when reach it, so we need not to compare prefix
+  // key by key and storage can stop reading blocks beyond it.
+  std::string iterate_upper_bound_;
 
  public:
   VirtualDBReadOption() : snapshot_(nullptr) {}
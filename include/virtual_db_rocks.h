@@ -20,7 +20,9 @@
 
 #include "codec.h"
 #include "codec_doclist_impl.h"
+#include "completion_list.h"
 #include "header.h"
+#include "term_dictionary.h"
 #include "virtual_db.h"
 
 #include "db/db_impl.h"
@@ -78,6 +80,80 @@ class ConcatMergeOperator : public rocksdb::MergeOperator {
  private:
 };
 
+// Sum doc frequency delta of term dictionary.
+class DocFreqMergeOperator : public rocksdb::AssociativeMergeOperator {
+ public:
+  DocFreqMergeOperator() {}
+  virtual ~DocFreqMergeOperator() {}
+
+  virtual bool Merge(const rocksdb::Slice& key,
+                     const rocksdb::Slice* existing_value,
+                     const rocksdb::Slice& value, std::string* new_value,
+                     rocksdb::Logger* logger) const override {
+    if (nullptr != existing_value) {
+      Slice existing(existing_value->data(), existing_value->size());
+      TermDictionary::MergeDocFreq(&existing, Slice(value.data(), value.size()),
+                                   *new_value);
+    } else {
+      TermDictionary::MergeDocFreq(nullptr, Slice(value.data(), value.size()),
+                                   *new_value);
+    }
+    return true;
+  }
+
+  virtual const char* Name() const override { return "DocFreqMergeOperator"; }
+};
+
+// Drop dictionary term whose doc frequency falls to 0.Only full values
+// come here,merge operands are deltas and kept by rocksdb.
+class DocFreqCompactionFilter : public VirtualDBRocksCompactionFilter {
+ public:
+  DocFreqCompactionFilter() {}
+  virtual ~DocFreqCompactionFilter() {}
+
+  virtual bool Filter(int level, const rocksdb::Slice& key,
+                      const rocksdb::Slice& existing_value,
+                      std::string* new_value,
+                      bool* value_changed) const override {
+    Slice value(existing_value.data(), existing_value.size());
+    return TermDictionary::DecodeDocFreq(value) <= 0;
+  }
+
+  virtual const char* Name() const override {
+    return "DocFreqCompactionFilter";
+  }
+};
+
+// Fold top terms of completion index,see CompletionList.
+// Not associative,so operands are only merged in full merge.
+class CompletionMergeOperator : public rocksdb::MergeOperator {
+ public:
+  CompletionMergeOperator() {}
+  virtual ~CompletionMergeOperator() {}
+
+  virtual bool FullMergeV2(
+      const rocksdb::MergeOperator::MergeOperationInput& merge_in,
+      rocksdb::MergeOperator::MergeOperationOutput* merge_out) const override {
+    CompletionList list;
+    if (nullptr != merge_in.existing_value) {
+      list.Deserialize(Slice(merge_in.existing_value->data(),
+                             merge_in.existing_value->size()));
+    }
+    for (const auto& item : merge_in.operand_list) {
+      CompletionList operand;
+      operand.Deserialize(Slice(item.data(), item.size()));
+      list.Merge(operand);
+    }
+    merge_out->new_value.clear();
+    list.SerializeToBytes(merge_out->new_value);
+    return true;
+  }
+
+  virtual const char* Name() const override {
+    return "CompletionMergeOperator";
+  }
+};
+
 // Another optimize merger.
 namespace merge {
 struct DocList {
@@ -0,0 +1,66 @@
+/*
+ * Tencent is pleased to support the open source community by making wwsearch
+ * available.
+ *
+ * Copyright (C) 2018-present Tencent. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * https://opensource.org/licenses/Apache-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OF ANY KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+#pragma once
+
+#include "header.h"
+#include "query.h"
+
+namespace wwsearch {
+
+/* Notice : Match terms of field by pattern,'*' matches any code points and
+ * '?' matches exactly one,e.g. "*foo*","fo?bar".Terms are resolved against
+ * distinct terms of field,seeking to the literal prefix before first
+ * wildcard,so infix match do not need suffix terms at index time.
+ * Pattern leading with '*' walks all terms of field,bounded by
+ * max_expansion_terms.
+ */
+class WildcardQuery : public Query {
+ private:
+  FieldID field_id_;
+  std::string pattern_;
+  // code points of pattern.
+  std::vector<uint32_t> pattern_code_points_;
+  // bytes before first wildcard.
+  std::string literal_prefix_;
+  uint32_t max_expansion_terms_;
+
+ public:
+  WildcardQuery(FieldID field_id, const std::string &pattern,
+                uint32_t max_expansion_terms = 1000);
+
+  virtual ~WildcardQuery();
+
+  virtual Weight *CreateWeight(SearchContext *context, bool needs_scores,
+                               double boost) override;
+
+  FieldID GetFieldID() { return this->field_id_; }
+
+  inline std::string &Pattern() { return this->pattern_; }
+
+  inline std::string &LiteralPrefix() { return this->literal_prefix_; }
+
+  inline uint32_t MaxExpansionTerms() { return this->max_expansion_terms_; }
+
+  // Return true if term matches whole pattern.
+  bool Match(const std::string &term);
+
+ private:
+};
+
+}  // namespace wwsearch
@@ -0,0 +1,53 @@
+/*
+ * Tencent is pleased to support the open source community by making wwsearch
+ * available.
+ *
+ * Copyright (C) 2018-present Tencent. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * https://opensource.org/licenses/Apache-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OF ANY KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+#pragma once
+
+#include "term_expansion.h"
+#include "weight.h"
+#include "wildcard_query.h"
+
+namespace wwsearch {
+
+class WildcardWeight : public Weight {
+ private:
+  TermExpansion expansion_;
+  Codec *codec_;  // outer reference.
+
+ public:
+  WildcardWeight(WildcardQuery *query);
+
+  virtual ~WildcardWeight();
+
+  virtual Scorer *GetScorer(SearchContext *context);
+
+  virtual BulkScorer *GetBulkScorer(SearchContext *context);
+
+ private:
+  // Fill doc lists of matched terms.
+  void MatchByInvertedIndex(SearchContext *context,
+                            std::vector<std::string> &doc_lists);
+
+  void MatchByDictionary(SearchContext *context,
+                         std::vector<std::string> &doc_lists);
+
+  // Set status if MaxExpansionTerms reached.
+  bool ReachExpansionLimit(SearchContext *context, size_t term_count);
+};
+
+}  // namespace wwsearch
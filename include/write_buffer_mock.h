@@ -77,5 +77,7 @@ class WriteBufferMock : public WriteBuffer {
   // Inner serialize api
   SearchStatus SeriableData();
   SearchStatus DeSeriableData();
+  // Apply records by type,so merge and delete survive serialization.
+  SearchStatus Replay(const lsmsearch::MockDataList& data_list);
 };
 }  // namespace wwsearch
@@ -0,0 +1,146 @@
+/*
+ * Tencent is pleased to support the open source community by making wwsearch
+ * available.
+ *
+ * Copyright (C) 2018-present Tencent. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * https://opensource.org/licenses/Apache-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OF ANY KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+#include "aggregation.h"
+#include <algorithm>
+#include "coding.h"
+
+namespace wwsearch {
+
+uint64_t AggregationMetricValue::Value(kAggregationMetricType type) const {
+  switch (type) {
+    case kAggregationCount:
+      return count;
+    case kAggregationSum:
+      return sum;
+    case kAggregationMin:
+      return numeric_count > 0 ? min : 0;
+    case kAggregationMax:
+      return max;
+    default:
+      return 0;
+  }
+}
+
+void Aggregation::GroupByTerms(FieldID field_id) {
+  group_type_ = kGroupTerms;
+  group_field_id_ = field_id;
+}
+
+void Aggregation::GroupByHistogram(FieldID field_id, uint64_t interval) {
+  assert(interval > 0);
+  group_type_ = kGroupHistogram;
+  group_field_id_ = field_id;
+  interval_ = interval;
+}
+
+void Aggregation::AddMetric(kAggregationMetricType type, FieldID field_id) {
+  metrics_.emplace_back(type, field_id);
+}
+
+static bool IsNumericField(const IndexField *field) {
+  return field->FieldType() == kUint32IndexField ||
+         field->FieldType() == kUint64IndexField;
+}
+
+void Aggregation::Collect(Document *document) {
+  // bucket key : type | value
+  std::string key;
+  bool is_string = false;
+  uint64_t numeric_key = 0;
+  if (kGroupNone != group_type_) {
+    IndexField *field = document->FindField(group_field_id_);
+    if (nullptr == field ||
+        (kGroupHistogram == group_type_ && !IsNumericField(field))) {
+      missing_doc_count_++;
+      return;
+    }
+    if (IsNumericField(field)) {
+      numeric_key = field->NumericValue();
+      if (kGroupHistogram == group_type_) {
+        numeric_key -= numeric_key % interval_;
+      }
+      AppendFixed8(key, 0);
+      AppendFixed64(key, numeric_key);
+    } else {
+      is_string = true;
+      AppendFixed8(key, 1);
+      key.append(field->StringValue());
+    }
+  }
+
+  auto iter = buckets_.find(key);
+  if (iter == buckets_.end()) {
+    AggregationBucket &bucket = buckets_[key];
+    bucket.is_string = is_string;
+    if (is_string) {
+      bucket.string_key = key.substr(1);
+    }
+    bucket.numeric_key = numeric_key;
+    bucket.metrics.resize(metrics_.size());
+    iter = buckets_.find(key);
+  }
+
+  AggregationBucket &bucket = iter->second;
+  bucket.doc_count++;
+  for (size_t i = 0; i < metrics_.size(); i++) {
+    IndexField *field = document->FindField(metrics_[i].second);
+    if (nullptr == field) continue;
+    AggregationMetricValue &value = bucket.metrics[i];
+    value.count++;
+    if (!IsNumericField(field)) continue;
+    uint64_t numeric = field->NumericValue();
+    value.numeric_count++;
+    value.sum += numeric;
+    value.min = std::min(value.min, numeric);
+    value.max = std::max(value.max, numeric);
+  }
+}
+
+void Aggregation::GetBuckets(std::vector<AggregationBucket> &buckets) {
+  size_t begin = buckets.size();
+  for (auto &kv : buckets_) {
+    buckets.push_back(kv.second);
+  }
+  if (kGroupHistogram == group_type_) {
+    std::sort(buckets.begin() + begin, buckets.end(),
+              [](const AggregationBucket &l, const AggregationBucket &r) {
+                return l.numeric_key < r.numeric_key;
+              });
+  } else {
+    std::sort(buckets.begin() + begin, buckets.end(),
+              [](const AggregationBucket &l, const AggregationBucket &r) {
+                if (l.doc_count != r.doc_count) {
+                  return l.doc_count > r.doc_count;
+                }
+                if (l.is_string != r.is_string) return r.is_string;
+                if (l.is_string) return l.string_key < r.string_key;
+                return l.numeric_key < r.numeric_key;
+              });
+  }
+  if (buckets.size() - begin > max_buckets_) {
+    buckets.resize(begin + max_buckets_);
+  }
+}
+
+void Aggregation::Clear() {
+  buckets_.clear();
+  missing_doc_count_ = 0;
+}
+
+}  // namespace wwsearch
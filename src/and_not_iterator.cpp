@@ -0,0 +1,77 @@
+/*
+ * Tencent is pleased to support the open source community by making wwsearch
+ * available.
+ *
+ * Copyright (C) 2018-present Tencent. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * https://opensource.org/licenses/Apache-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OF ANY KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+#include "and_not_iterator.h"
+#include "logger.h"
+
+namespace wwsearch {
+
+DocumentID AndNotIterator::DocID() { return curr_; }
+
+DocumentID AndNotIterator::NextDoc() {
+  curr_ = SkipExcluded(required_iterator_->NextDoc());
+  return curr_;
+}
+
+DocumentID AndNotIterator::Advance(DocumentID target) {
+  curr_ = SkipExcluded(required_iterator_->Advance(target));
+  return curr_;
+}
+
+CostType AndNotIterator::Cost() {
+  if (nullptr == required_iterator_) return 0;
+  return required_iterator_->Cost();
+}
+
+int AndNotIterator::FieldId() {
+  if (nullptr == required_iterator_) return -1;
+  return required_iterator_->FieldId();
+}
+
+void AndNotIterator::FinishAddIterator() {
+  if (nullptr == required_iterator_) {
+    curr_ = NO_MORE_DOCS;
+    return;
+  }
+  // back to head like required iterator.
+  for (auto iterator : excluded_iterator_) {
+    iterator->Advance(MAX_DOCID);
+  }
+  curr_ = SkipExcluded(required_iterator_->DocID());
+}
+
+DocumentID AndNotIterator::SkipExcluded(DocumentID candidate) {
+  while (candidate != NO_MORE_DOCS) {
+    bool excluded = false;
+    for (auto iterator : excluded_iterator_) {
+      if (iterator->DocID() > candidate) {
+        iterator->Advance(candidate);
+      }
+      if (iterator->DocID() == candidate) {
+        excluded = true;
+        break;
+      }
+    }
+    if (!excluded) break;
+    SearchLogDebug("AndNot drop excluded doc=%llu", candidate);
+    candidate = required_iterator_->NextDoc();
+  }
+  return candidate;
+}
+
+}  // namespace wwsearch
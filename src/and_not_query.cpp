@@ -0,0 +1,35 @@
+/*
+ * Tencent is pleased to support the open source community by making wwsearch
+ * available.
+ *
+ * Copyright (C) 2018-present Tencent. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * https://opensource.org/licenses/Apache-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OF ANY KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+#include "and_not_query.h"
+#include "and_not_weight.h"
+namespace wwsearch {
+
+Weight* AndNotQuery::CreateWeight(SearchContext* context, bool needs_scores,
+                                  double boost) {
+  AndNotWeight* weight = new AndNotWeight(this);
+  for (auto q : this->required_query_) {
+    weight->AddWeight(q->CreateWeight(context, needs_scores, 0));
+  }
+  for (auto q : this->excluded_query_) {
+    weight->AddNotWeight(q->CreateWeight(context, false, 0));
+  }
+  return weight;
+}
+
+}  // namespace wwsearch
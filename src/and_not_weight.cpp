@@ -0,0 +1,57 @@
+/*
+ * Tencent is pleased to support the open source community by making wwsearch
+ * available.
+ *
+ * Copyright (C) 2018-present Tencent. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * https://opensource.org/licenses/Apache-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OF ANY KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+#include "and_not_weight.h"
+#include "and_not_scorer.h"
+#include "logger.h"
+
+namespace wwsearch {
+
+Scorer* AndNotWeight::GetScorer(SearchContext* context) {
+  AndNotScorer* scorer = new AndNotScorer(this);
+  for (auto w : required_weight_) {
+    Scorer* s = w->GetScorer(context);
+    if (nullptr == s) {
+      // error happen
+      delete scorer;
+      return nullptr;
+    }
+    scorer->AddScorer(s);
+    if (s->Iterator().DocID() == DocIdSetIterator::NO_MORE_DOCS) {
+      SearchLogDebug("AndNotWeight short circuit by empty sub scorer");
+      return scorer;
+    }
+  }
+  for (auto w : excluded_weight_) {
+    Scorer* s = w->GetScorer(context);
+    if (nullptr == s) {
+      delete scorer;
+      return nullptr;
+    }
+    scorer->AddNotScorer(s);
+  }
+  return scorer;
+}
+
+BulkScorer* AndNotWeight::GetBulkScorer(SearchContext* context) {
+  // not implementataion now
+  assert(false);
+  return nullptr;
+}
+
+}  // namespace wwsearch
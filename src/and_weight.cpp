@@ -18,6 +18,7 @@
 
 #include "and_weight.h"
 #include "and_scorer.h"
+#include "logger.h"
 
 namespace wwsearch {
 
@@ -31,6 +32,11 @@ Scorer* AndWeight::GetScorer(SearchContext* context) {
       return nullptr;
     }
     scorer->AddScorer(s);
+    // one required sub query is empty,no need to read others.
+    if (s->Iterator().DocID() == DocIdSetIterator::NO_MORE_DOCS) {
+      SearchLogDebug("AndWeight short circuit by empty sub scorer");
+      break;
+    }
   }
   return scorer;
 }
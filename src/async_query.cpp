@@ -0,0 +1,136 @@
+/*
+ * Tencent is pleased to support the open source community by making wwsearch
+ * available.
+ *
+ * Copyright (C) 2018-present Tencent. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * https://opensource.org/licenses/Apache-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OF ANY KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+#include "async_query.h"
+#include "collector_top.h"
+#include "filter_pushdown.h"
+#include "query_rewriter.h"
+#include "scorer.h"
+#include "searcher.h"
+#include "thread_pool.h"
+#include "weight.h"
+
+namespace wwsearch {
+
+AsyncQuery::AsyncQuery(Searcher *searcher, IndexConfig *config,
+                       ThreadPool *executor, const TableID &table,
+                       Query &query, size_t offset, size_t limit,
+                       std::vector<Filter *> *filter,
+                       std::vector<SortCondition *> *sorter,
+                       uint32_t min_match_filter_num, SearchDeadline *deadline,
+                       SearchCallback callback)
+    : searcher_(searcher),
+      config_(config),
+      executor_(executor),
+      table_(table),
+      query_(&query),
+      offset_(offset),
+      limit_(limit),
+      filter_(filter),
+      sorter_(sorter),
+      min_match_filter_num_(min_match_filter_num),
+      deadline_(deadline),
+      callback_(callback),
+      snapshot_(nullptr),
+      context_(nullptr),
+      pushdown_(nullptr),
+      rewriter_(nullptr),
+      weight_(nullptr),
+      scorer_(nullptr),
+      collector_(nullptr) {}
+
+AsyncQuery::~AsyncQuery() {
+  delete collector_;
+  delete scorer_;
+  delete weight_;
+  delete rewriter_;
+  delete pushdown_;
+  delete context_;
+  if (nullptr != snapshot_) {
+    config_->VDB()->ReleaseSnapshot(snapshot_);
+  }
+}
+
+void AsyncQuery::Start() {
+  executor_->Submit([this] { Open(); });
+}
+
+void AsyncQuery::Open() {
+  VirtualDB *vdb = config_->VDB();
+  uint64_t read_version = config_->GetTableVersion()->Get(table_);
+  snapshot_ = vdb->NewSnapshot();
+  context_ = new SearchContext(table_, vdb, snapshot_, config_);
+  context_->SetReadVersion(read_version);
+  context_->SetDeadline(deadline_);
+
+  pushdown_ = new FilterPushdown(config_);
+  Query *real_query = pushdown_->Plan(query_, filter_, min_match_filter_num_);
+  rewriter_ = new QueryRewriter(context_);
+  real_query = rewriter_->Rewrite(real_query);
+
+  weight_ = real_query->CreateWeight(context_, false, 0);
+  scorer_ = weight_->GetScorer(context_);
+  if (nullptr == scorer_) {
+    SearchStatus status = context_->Status();
+    if (status.OK()) {
+      status.SetStatus(kScorerErrorStatus, "can not get scorer");
+    }
+    Done(status);
+    return;
+  }
+
+  collector_ = new TopNCollector(table_, offset_, limit_, searcher_, context_,
+                                 filter_, sorter_, nullptr, SIZE_MAX,
+                                 min_match_filter_num_, &tracer_, nullptr);
+  collector_->SetScorer(scorer_);
+  executor_->Submit([this] { CollectBatch(); });
+}
+
+// One batch is what collector purges at once(its size adapts to filter
+// pass rate),so docvalue of it is read by one MultiGet before thread is
+// released.
+void AsyncQuery::CollectBatch() {
+  size_t batch = collector_->RemainingBatchDocs();
+  DocIdSetIterator &doc_lists = scorer_->Iterator();
+  for (size_t i = 0; i < batch; i++) {
+    if (doc_lists.DocID() == DocIdSetIterator::NO_MORE_DOCS ||
+        collector_->Enough() || context_->Interrupted()) {
+      collector_->Finish();
+      Done(collector_->Status());
+      return;
+    }
+    collector_->Collect(doc_lists.DocID(), doc_lists.FieldId());
+    doc_lists.NextDoc();
+  }
+  executor_->Submit([this] { CollectBatch(); });
+}
+
+void AsyncQuery::Done(SearchStatus status) {
+  std::list<DocumentID> docs;
+  if (status.OK()) {
+    collector_->GetAndClearMatchDocs(docs);
+    // partial docs are returned with timeout.
+    if (!context_->Status().OK()) {
+      status = context_->Status();
+    }
+  }
+  callback_(status, docs);
+  delete this;
+}
+
+}  // namespace wwsearch
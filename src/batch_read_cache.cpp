@@ -0,0 +1,57 @@
+/*
+ * Tencent is pleased to support the open source community by making wwsearch
+ * available.
+ *
+ * Copyright (C) 2018-present Tencent. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * https://opensource.org/licenses/Apache-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OF ANY KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+#include "batch_read_cache.h"
+#include "coding.h"
+
+namespace wwsearch {
+
+const BatchReadCache::Entry *BatchReadCache::Get(StorageColumnType column,
+                                                 const std::string &key) {
+  std::string cache_key;
+  EncodeKey(column, key, cache_key);
+  auto iter = values_.find(cache_key);
+  if (iter == values_.end()) return nullptr;
+  return &iter->second;
+}
+
+const BatchReadCache::Entry *BatchReadCache::Put(StorageColumnType column,
+                                                 const std::string &key,
+                                                 const SearchStatus &status,
+                                                 std::string &value) {
+  std::string cache_key;
+  EncodeKey(column, key, cache_key);
+  size_t bytes = cache_key.size() + value.size();
+  auto iter = values_.find(cache_key);
+  if (iter != values_.end()) return &iter->second;
+  if (bytes_ + bytes > max_bytes_) return nullptr;
+  bytes_ += bytes;
+  Entry &item = values_[cache_key];
+  item.status = status;
+  item.value.swap(value);
+  return &item;
+}
+
+void BatchReadCache::EncodeKey(StorageColumnType column,
+                               const std::string &key,
+                               std::string &cache_key) {
+  AppendFixed8(cache_key, column);
+  cache_key.append(key);
+}
+
+}  // namespace wwsearch
@@ -19,6 +19,7 @@
 #include "bool_weight.h"
 #include "bool_scorer.h"
 #include "codec_doclist_impl.h"
+#include "doclist_compression.h"
 #include "func_scope_guard.h"
 #include "header.h"
 #include "search_status.h"
@@ -41,20 +42,7 @@ Scorer *BooleanWeight::GetScorer(SearchContext *context) {
   std::vector<SearchStatus> status;
   {
     std::string key;
-    if (query->ValueType() == kStringIndexField) {
-      codec->EncodeInvertedKey(context->Table(), query->GetFieldID(),
-                               query->MatchTerm(), key);
-    } else if (query->ValueType() == kUint32IndexField) {
-      std::string term;
-      AppendFixed32(term, query->MatchNumeric());
-      codec->EncodeInvertedKey(context->Table(), query->GetFieldID(), term,
-                               key);
-    } else if (query->ValueType() == kUint64IndexField) {
-      std::string term;
-      AppendFixed64(term, query->MatchNumeric());
-      codec->EncodeInvertedKey(context->Table(), query->GetFieldID(), term,
-                               key);
-    } else {
+    if (!EncodeInvertedKey(context, query, key)) {
       context->Status().SetStatus(kScorerErrorStatus, "unknow valuetype");
       return nullptr;
     }
@@ -63,17 +51,50 @@ Scorer *BooleanWeight::GetScorer(SearchContext *context) {
     keys.push_back(key);
     columns.push_back(kInvertedIndexColumn);
   }
-  // TODO: need used snapshot for read
-  context->VDB()->MultiGet(columns, keys, values_, status,
-                           nullptr /*context->GetSnapshot()*/);
+  // Doc list of same key and table version never change.Version is read
+  // before snapshot,so doc list read by snapshot is not older than it.
+  DocListCache *cache = context->GetConfig()->GetDocListCache();
+  std::string cache_key;
+  if (TableVersion::kNoVersion == context->ReadVersion()) {
+    cache = nullptr;
+  }
+  if (nullptr != cache) {
+    cache_key = keys[0];
+    AppendFixed64(cache_key, context->ReadVersion());
+    cached_doc_list_ = cache->Get(cache_key);
+    if (nullptr != cached_doc_list_) {
+      SearchLogDebug("BooleanWeight hit doc list cache,size:%u",
+                     cached_doc_list_->size());
+      DocListReaderCodec *doc_lists = codec->NewDocListReaderCodec(
+          cached_doc_list_->c_str(), cached_doc_list_->size(),
+          query->GetFieldID());
+      return new BooleanScorer(this, doc_lists, codec);
+    }
+  }
+
+  // Batch of queries prefetch shared doc lists at once.
+  const std::string *doc_list = nullptr;
+  const BatchReadCache::Entry *entry = nullptr;
+  BatchReadCache *batch_read_cache = context->GetBatchReadCache();
+  if (nullptr != batch_read_cache) {
+    entry = batch_read_cache->Get(kInvertedIndexColumn, keys[0]);
+  }
+  if (nullptr != entry) {
+    status.push_back(entry->status);
+    doc_list = &entry->value;
+  } else {
+    context->VDB()->MultiGet(columns, keys, values_, status,
+                             context->GetSnapshot());
+    assert(values_.size() == 1);
+    doc_list = &values_[0];
+  }
   assert(keys.size() == status.size());
   SearchLogDebug(
       "GetScorer Table(%s), FieldID(%u), match_term(%s), keys_size(%d), "
-      "keys(%s), values_size(%d), values(%s)",
+      "keys(%s), doc_list_size(%d)",
       context->Table().PrintToStr().c_str(), query->GetFieldID(),
       query->MatchTerm().c_str(), keys.size(),
-      JoinContainerToString(keys, ";").c_str(), values_.size(),
-      JoinContainerToString(values_, ";").c_str());
+      JoinContainerToString(keys, ";").c_str(), doc_list->size());
   for (auto ss : status) {
     if (!ss.OK()) {
       // document not exist is ok,just return empty scorer
@@ -82,27 +103,90 @@ Scorer *BooleanWeight::GetScorer(SearchContext *context) {
         return nullptr;
       }
       // set to zero
-      values_[0].clear();
+      values_.assign(1, std::string());
+      doc_list = &values_[0];
     }
   }
 
-  SearchLogDebug("doclist len:%llu ", values_[0].size());
-  if (values_[0].size() > 0) {
+  SearchLogDebug("doclist len:%llu ", doc_list->size());
+  if (doc_list->size() > 0) {
     SearchLogDebug(
-        "GetScorer Table(%s), FieldID(%u), match_term(%s) values_[0](%s)",
+        "GetScorer Table(%s), FieldID(%u), match_term(%s) doc_list(%s)",
         context->Table().PrintToStr().c_str(), query->GetFieldID(),
         query->MatchTerm().c_str(),
-        DebugInvertedValueByReader(codec, values_[0]).c_str());
+        DebugInvertedValueByReader(codec, *doc_list).c_str());
+  }
+  if (nullptr != cache) {
+    AdmitDocListCache(context, cache, cache_key, *doc_list);
+  }
+  DocListReaderCodec *doc_lists = nullptr;
+  if (nullptr != cached_doc_list_) {
+    doc_lists = codec->NewDocListReaderCodec(cached_doc_list_->c_str(),
+                                             cached_doc_list_->size(),
+                                             query->GetFieldID());
+  } else {
+    doc_lists = codec->NewDocListReaderCodec(
+        doc_list->c_str(), doc_list->size(), query->GetFieldID());
   }
-  assert(values_.size() == 1);
-  DocListReaderCodec *doc_lists = codec->NewDocListReaderCodec(
-      values_[0].c_str(), values_[0].size(), query->GetFieldID());
 
   // codec will release doc_lists.
   BooleanScorer *scorer = new BooleanScorer(this, doc_lists, codec);
   return scorer;
 }
 
+bool BooleanWeight::EncodeInvertedKey(SearchContext *context,
+                                      BooleanQuery *query, std::string &key) {
+  Codec *codec = context->GetConfig()->GetCodec();
+  if (query->ValueType() == kStringIndexField) {
+    codec->EncodeInvertedKey(context->Table(), query->GetFieldID(),
+                             query->MatchTerm(), key);
+  } else if (query->ValueType() == kUint32IndexField) {
+    std::string term;
+    AppendFixed32(term, query->MatchNumeric());
+    codec->EncodeInvertedKey(context->Table(), query->GetFieldID(), term, key);
+  } else if (query->ValueType() == kUint64IndexField) {
+    std::string term;
+    AppendFixed64(term, query->MatchNumeric());
+    codec->EncodeInvertedKey(context->Table(), query->GetFieldID(), term, key);
+  } else {
+    return false;
+  }
+  return true;
+}
+
+void BooleanWeight::AdmitDocListCache(SearchContext *context,
+                                      DocListCache *cache,
+                                      const std::string &cache_key,
+                                      const std::string &value) {
+  size_t fix_item_size = sizeof(DocumentID) + sizeof(DocumentState);
+  // Compressed size is smaller than decoded one,skip small list quickly.
+  if (value.size() < sizeof(DocListHeader) + cache->MinDocListSize()) return;
+
+  bool use_buffer = false;
+  std::string *buffer = new std::string;
+  if (!context->GetConfig()->GetCodec()->DecodeDocListToFixBytes(
+          value.c_str(), value.size(), use_buffer, *buffer)) {
+    delete buffer;
+    return;
+  }
+  if (use_buffer) {
+    // decoded buffer keep the compression header,reset it to fixed type.
+    DocListHeader header;
+    header.version = DocListCompressionFixType;
+    memcpy(&(*buffer)[0], &header, sizeof(header));
+  } else {
+    buffer->assign(value);
+  }
+
+  size_t doc_num = (buffer->size() - sizeof(DocListHeader)) / fix_item_size;
+  if (doc_num < cache->MinDocListSize()) {
+    delete buffer;
+    return;
+  }
+  cached_doc_list_.reset(buffer);
+  cache->Put(cache_key, cached_doc_list_);
+}
+
 BulkScorer *BooleanWeight::GetBulkScorer(SearchContext *context) {
   return nullptr;
 }
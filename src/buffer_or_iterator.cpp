@@ -0,0 +1,124 @@
+/*
+ * Tencent is pleased to support the open source community by making wwsearch
+ * available.
+ *
+ * Copyright (C) 2018-present Tencent. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * https://opensource.org/licenses/Apache-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OF ANY KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+#include "buffer_or_iterator.h"
+#include <algorithm>
+#include <functional>
+#include "header.h"
+#include "logger.h"
+
+namespace wwsearch {
+
+DocumentID BufferOrIterator::DocID() {
+  if (pos_ >= docs_.size()) return NO_MORE_DOCS;
+  return docs_[pos_];
+}
+
+DocumentID BufferOrIterator::NextDoc() {
+  if (pos_ < docs_.size()) {
+    pos_++;
+  }
+  return DocID();
+}
+
+DocumentID BufferOrIterator::Advance(DocumentID target) {
+  // in decrease order
+  // find equal or first less than {target} 's document id.
+  auto it = std::lower_bound(docs_.begin(), docs_.end(), target,
+                             std::greater<DocumentID>());
+  pos_ = it - docs_.begin();
+  return DocID();
+}
+
+CostType BufferOrIterator::Cost() { return docs_.size(); }
+
+void BufferOrIterator::AddSubIterator(DocIdSetIterator* iterator) {
+  for (DocumentID doc_id = iterator->DocID(); doc_id != NO_MORE_DOCS;
+       doc_id = iterator->NextDoc()) {
+    int field_id = iterator->FieldId();
+    if (field_id_ < 0) field_id_ = field_id;
+    if (fields_.empty() && field_id != field_id_) {
+      // first doc of another field,track field per doc from now.
+      fields_.assign(docs_.size(), field_id_);
+    }
+    docs_.push_back(doc_id);
+    if (!fields_.empty()) fields_.push_back(field_id);
+  }
+}
+
+void BufferOrIterator::FinishAddIterator() {
+  if (docs_.empty()) return;
+  if (!fields_.empty()) {
+    FinishWithFields();
+    return;
+  }
+  auto minmax = std::minmax_element(docs_.begin(), docs_.end());
+  DocumentID min_doc = *minmax.first;
+  uint64_t range = *minmax.second - min_doc + 1;
+
+  // Dense docs : one pass bitmap is cheaper than sorting.
+  if (range / 64 <= docs_.size()) {
+    std::vector<uint64_t> bitmap((range + 63) / 64, 0);
+    for (auto doc_id : docs_) {
+      uint64_t offset = doc_id - min_doc;
+      bitmap[offset / 64] |= (1ULL << (offset % 64));
+    }
+    docs_.clear();
+    for (size_t i = bitmap.size(); i > 0; --i) {
+      uint64_t bits = bitmap[i - 1];
+      while (bits != 0) {
+        int high = 63 - __builtin_clzll(bits);
+        docs_.push_back(min_doc + (i - 1) * 64 + high);
+        bits &= ~(1ULL << high);
+      }
+    }
+  } else {
+    std::sort(docs_.begin(), docs_.end(), std::greater<DocumentID>());
+    docs_.erase(std::unique(docs_.begin(), docs_.end()), docs_.end());
+  }
+  pos_ = 0;
+  SearchLogDebug("BufferOrIterator finish, docs=%u, range=%llu", docs_.size(),
+                 range);
+}
+
+// Bitmap drops field id,so sort doc with its field.Doc matched by several
+// fields keeps the first one added.
+void BufferOrIterator::FinishWithFields() {
+  std::vector<std::pair<DocumentID, int>> docs;
+  docs.reserve(docs_.size());
+  for (size_t i = 0; i < docs_.size(); i++) {
+    docs.emplace_back(docs_[i], fields_[i]);
+  }
+  std::stable_sort(docs.begin(), docs.end(),
+                   [](const std::pair<DocumentID, int>& a,
+                      const std::pair<DocumentID, int>& b) {
+                     return a.first > b.first;
+                   });
+  docs_.clear();
+  fields_.clear();
+  for (const auto& doc : docs) {
+    if (!docs_.empty() && docs_.back() == doc.first) continue;
+    docs_.push_back(doc.first);
+    fields_.push_back(doc.second);
+  }
+  pos_ = 0;
+  SearchLogDebug("BufferOrIterator finish with fields, docs=%u",
+                 docs_.size());
+}
+
+}  // namespace wwsearch
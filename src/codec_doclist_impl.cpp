@@ -172,10 +172,7 @@ DocumentID DocListReaderCodecImpl::Advance(DocumentID target) {
   return DocID();
 }
 
-CostType DocListReaderCodecImpl::Cost() {
-  assert(false);
-  return 0;
-}
+CostType DocListReaderCodecImpl::Cost() { return slice_.size() / DOC_ID_GAP; }
 
 DocumentState& DocListReaderCodecImpl::State() {
   if (pos_ >= slice_.size()) assert(false);
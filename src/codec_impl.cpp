@@ -188,4 +188,15 @@ void CodecImpl::EncodeSequenceMappingKey(const TableID& table,
   key.append(user_id);
 }
 
+void CodecImpl::EncodeCompletionKey(const TableID& table,
+                                    const FieldID& field_id,
+                                    const std::string& prefix,
+                                    std::string& key) {
+  AppendFixed8(key, table.business_type);
+  AppendFixed64(key, table.partition_set);
+  AppendFixed8(key, 2);
+  AppendFixed8(key, field_id);
+  key.append(prefix);
+}
+
 }  // namespace wwsearch
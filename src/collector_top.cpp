@@ -18,6 +18,7 @@
 
 #include "collector_top.h"
 #include "searcher.h"
+#include "thread_pool.h"
 
 namespace wwsearch {
 
@@ -45,16 +46,21 @@ void TopNCollector::Collect(DocumentID doc_id, int field_id) {
 
   inner_purge_total_docs_count_ += 1;
 
-  if (buffer_docs_.size() >= index_config->GetMaxInnerPurgeBatchDocsCount()) {
-    InnerPurge();
+  if (buffer_docs_.size() >= batch_size_) {
+    if (nullptr != prefetch_pool_) {
+      PrefetchPurge();
+    } else {
+      InnerPurge();
+    }
     assert(buffer_docs_.empty());
+    batch_size_ = NextBatchSize();
   }
 }
 
 // If we can finish collect?
 bool TopNCollector::Enough() {
   if (!status_.OK()) return true;
-  if (!quick_top_n) return false;
+  if (!quick_top_n || nullptr != aggregations_) return false;
   return (this->topN_docs_.size() >= this->top_n_) &&
          (nullptr ==
           get_match_total_cnt_) /* get_match_total_cnt nullptr means no need get
@@ -101,6 +107,7 @@ void TopNCollector::HandleScorePriorityQueue() {
 
 // Finish our job.
 void TopNCollector::Finish() {
+  FinishFetch();
   InnerPurge();
   HandleScorePriorityQueue();
 }
@@ -122,12 +129,43 @@ void TopNCollector::GetAndClearMatchDocs(std::list<DocumentID> &docs) {
   }
 }
 
+bool TopNCollector::MatchIndexSort(IndexConfig *config,
+                                   std::vector<SortCondition *> *sorter) {
+  if (nullptr == sorter || 1 != sorter->size()) return false;
+  if (config->GetIndexSortField() < 0) return false;
+  // Ties of sort field are in descending doc id,same as Sorter.
+  NumericSortCondition *condition =
+      dynamic_cast<NumericSortCondition *>((*sorter)[0]);
+  return nullptr != condition &&
+         condition->GetID() == config->GetIndexSortField() &&
+         kSortConditionDesc == condition->SortType();
+}
+
+void TopNCollector::GetAndClearTopDocs(std::vector<Document *> &docs) {
+  while (topN_docs_.size() > 0) {
+    docs.push_back(topN_docs_.top());
+    topN_docs_.pop();
+  }
+}
+
+void TopNCollector::MergeTopDocs(std::vector<Document *> &docs) {
+  for (auto document : docs) {
+    topN_docs_.push(document);
+    if (topN_docs_.size() > top_n_) {
+      delete topN_docs_.top();
+      topN_docs_.pop();
+    }
+  }
+  docs.clear();
+}
+
 // Read document's info to check filter etc.
 void TopNCollector::InnerPurge() {
   if (buffer_docs_.empty()) return;
 
-  // Optimize
-  if (nullptr == sorter_ && nullptr == filter_ && !use_score_strategy_) {
+  // Optimize,documents without field are sorted by doc id.
+  if ((nullptr == sorter_ || index_sorted_) && nullptr == filter_ &&
+      nullptr == aggregations_ && !use_score_strategy_) {
     for (size_t i = 0; i < buffer_docs_.size(); i++) {
       if (topN_docs_.size() < top_n_) {
         topN_docs_.push(buffer_docs_[i]);
@@ -148,25 +186,40 @@ void TopNCollector::InnerPurge() {
     return;
   }
 
+  // Query is interrupted,drop batch before reading docvalue and keep top
+  // docs of earlier batches as partial result.
+  if (search_context_->Interrupted()) {
+    for (auto document : buffer_docs_) {
+      delete document;
+    }
+    buffer_docs_.clear();
+    return;
+  }
+
   std::vector<SearchStatus> ss;
   SearchLogDebug("buffer_docs_size:%u", buffer_docs_.size());
-  {
-    TimeCostCounter get_docvalue_consume_us;
-    get_docvalue_consume_us.Start();
-    auto ret =
-        this->searcher_->GetDocValue(table_, buffer_docs_, ss, search_context_);
-    if (!ret.OK()) {
-      for (auto document : buffer_docs_) {
-        delete document;
-      }
-      buffer_docs_.clear();
-      status_ = ret;
-      return;
-    }
+  TimeCostCounter get_docvalue_consume_us;
+  get_docvalue_consume_us.Start();
+  auto ret =
+      this->searcher_->GetDocValue(table_, buffer_docs_, ss, search_context_);
+  if (ret.OK()) {
     tracer_->Add(TracerType::kGetDocvalueConsumeUsInCollector,
                  get_docvalue_consume_us.CostUs());
     tracer_->Add(TracerType::kGetDocvalueCountInCollector, ss.size());
   }
+  PurgeFetched(ret, ss);
+}
+
+void TopNCollector::PurgeFetched(SearchStatus &ret,
+                                 std::vector<SearchStatus> &ss) {
+  if (!ret.OK()) {
+    for (auto document : buffer_docs_) {
+      delete document;
+    }
+    buffer_docs_.clear();
+    status_ = ret;
+    return;
+  }
 
   std::vector<Document *> hit_documents;
 
@@ -175,6 +228,7 @@ void TopNCollector::InnerPurge() {
     filter_consume_us.Start();
     assert(ss.size() == buffer_docs_.size());
     uint64_t filter_hit_count = 0;
+    Sorter sorter(sorter_);
     for (size_t i = 0; i < ss.size(); i++) {
       if (ss[i].OK() || ss[i].DocumentNotExist()) {
         auto document = buffer_docs_[i];
@@ -182,6 +236,14 @@ void TopNCollector::InnerPurge() {
           SearchLogDebug("filter not pass doc=%lu\n", document->ID());
           continue;
         }
+        if (nullptr != search_after_ && !sorter(search_after_, document)) {
+          continue;
+        }
+        if (nullptr != aggregations_) {
+          for (auto aggregation : *aggregations_) {
+            aggregation->Collect(document);
+          }
+        }
         filter_hit_count++;
 
         if (nullptr != get_match_total_cnt_) {
@@ -209,6 +271,8 @@ void TopNCollector::InnerPurge() {
     tracer_->Add(TracerType::kFilterConsumeUsInCollector,
                  filter_consume_us.CostUs());
     tracer_->Add(TracerType::kFilterHitCountInCollector, filter_hit_count);
+    filter_checked_docs_ += ss.size();
+    filter_passed_docs_ += filter_hit_count;
   }
 
   SearchLogDebug("Before GetStoredFields");
@@ -305,6 +369,115 @@ void TopNCollector::InnerPurge() {
   return;
 }
 
+void TopNCollector::PrefetchPurge() {
+  // No docvalue to read,or order of purge matters.
+  if (((nullptr == sorter_ || index_sorted_) && nullptr == filter_ &&
+       nullptr == aggregations_) ||
+      use_score_strategy_) {
+    InnerPurge();
+    return;
+  }
+
+  FinishFetch();
+  if (!status_.OK() || search_context_->Interrupted()) {
+    for (auto document : buffer_docs_) {
+      delete document;
+    }
+    buffer_docs_.clear();
+    return;
+  }
+
+  auto fetch = std::make_shared<DocValueFetch>();
+  fetch->docs.swap(buffer_docs_);
+  pending_fetch_ = fetch;
+  // Task holds fetch only,collector may be gone when it runs.
+  Searcher *searcher = searcher_;
+  TableID table = table_;
+  SearchContext *search_context = search_context_;
+  prefetch_pool_->Submit([fetch, searcher, table, search_context] {
+    RunFetch(fetch.get(), searcher, table, search_context);
+  });
+}
+
+void TopNCollector::FinishFetch() {
+  if (nullptr == pending_fetch_) return;
+  std::shared_ptr<DocValueFetch> fetch;
+  fetch.swap(pending_fetch_);
+  WaitFetch(fetch.get());
+  if (fetch->ret.OK()) {
+    tracer_->Add(TracerType::kGetDocvalueConsumeUsInCollector,
+                 fetch->consume_us);
+    tracer_->Add(TracerType::kGetDocvalueCountInCollector,
+                 fetch->status.size());
+  }
+  // purge fetched batch,then current batch is back to buffer.
+  buffer_docs_.swap(fetch->docs);
+  PurgeFetched(fetch->ret, fetch->status);
+  buffer_docs_.swap(fetch->docs);
+}
+
+void TopNCollector::RunFetch(DocValueFetch *fetch, Searcher *searcher,
+                             const TableID &table,
+                             SearchContext *search_context) {
+  {
+    std::lock_guard<std::mutex> guard(fetch->mutex);
+    if (fetch->started) return;
+    fetch->started = true;
+  }
+  TimeCostCounter consume_us;
+  consume_us.Start();
+  fetch->ret = searcher->GetDocValue(table, fetch->docs, fetch->status,
+                                     search_context);
+  fetch->consume_us = consume_us.CostUs();
+  {
+    std::lock_guard<std::mutex> guard(fetch->mutex);
+    fetch->done = true;
+  }
+  fetch->cond.notify_all();
+}
+
+// Run it here if pool has not started it,so busy pool never blocks us.
+void TopNCollector::WaitFetch(DocValueFetch *fetch) {
+  {
+    std::unique_lock<std::mutex> lock(fetch->mutex);
+    if (fetch->started) {
+      fetch->cond.wait(lock, [fetch] { return fetch->done; });
+      return;
+    }
+  }
+  RunFetch(fetch, searcher_, table_, search_context_);
+}
+
+// Result is thrown away,so only wait for a fetch that is already running.
+void TopNCollector::CancelFetch(DocValueFetch *fetch) {
+  std::unique_lock<std::mutex> lock(fetch->mutex);
+  if (!fetch->started) {
+    fetch->started = true;
+    return;
+  }
+  fetch->cond.wait(lock, [fetch] { return fetch->done; });
+}
+
+// Documents come in final order,only read what remaining top n needs by
+// filter pass rate.Otherwise all documents are read,full batch saves
+// MultiGet round trips.
+size_t TopNCollector::NextBatchSize() {
+  static const size_t kMinBatchDocsCount = 16;
+  size_t max_batch =
+      search_context_->GetConfig()->GetMaxInnerPurgeBatchDocsCount();
+  if (!quick_top_n || nullptr == filter_ || nullptr != get_match_total_cnt_ ||
+      nullptr != aggregations_ || use_score_strategy_ ||
+      topN_docs_.size() >= top_n_) {
+    return max_batch;
+  }
+  // smoothed,first batch assumes half pass.
+  double pass_rate =
+      (filter_passed_docs_ + 1.0) / (filter_checked_docs_ + 2.0);
+  size_t need = top_n_ - topN_docs_.size();
+  size_t batch = static_cast<size_t>(need / pass_rate * 1.2) + 1;
+  return std::min(max_batch, std::max(batch, kMinBatchDocsCount));
+}
+
 // Check if documents match filter.
 bool TopNCollector::MatchFilter(Document *document) {
   if (nullptr == this->filter_) return true;
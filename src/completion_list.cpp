@@ -0,0 +1,124 @@
+/*
+ * Tencent is pleased to support the open source community by making wwsearch
+ * available.
+ *
+ * Copyright (C) 2018-present Tencent. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * https://opensource.org/licenses/Apache-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OF ANY KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+#include "completion_list.h"
+#include <algorithm>
+#include "coding.h"
+
+namespace wwsearch {
+
+void CompletionList::Add(const std::string &term, int64_t delta,
+                         int64_t error) {
+  for (size_t i = 0; i < items_.size(); i++) {
+    Item &item = items_[i];
+    if (item.term != term) continue;
+    item.weight += delta;
+    item.error += error;
+    if (item.weight <= item.error) {
+      items_.erase(items_.begin() + i);
+    }
+    return;
+  }
+  // term not tracked,its weight is not counted by anyone,drop delete.
+  if (delta <= error) return;
+  if (items_.size() < capacity_) {
+    items_.push_back(Item{term, delta, error});
+    return;
+  }
+  if (items_.empty()) return;
+  auto lightest = std::min_element(
+      items_.begin(), items_.end(),
+      [](const Item &a, const Item &b) { return a.weight < b.weight; });
+  lightest->term = term;
+  lightest->error = lightest->weight + error;
+  lightest->weight += delta;
+}
+
+void CompletionList::Merge(const CompletionList &other) {
+  capacity_ = std::max(capacity_, other.capacity_);
+  for (const auto &item : other.items_) {
+    Add(item.term, item.weight, item.error);
+  }
+}
+
+void CompletionList::TopK(size_t k, std::vector<Entry> &entries) const {
+  entries.clear();
+  for (const auto &item : items_) {
+    entries.emplace_back(item.term, item.weight - item.error);
+  }
+  std::sort(entries.begin(), entries.end(),
+            [](const Entry &a, const Entry &b) {
+              return a.second != b.second ? a.second > b.second
+                                          : a.first < b.first;
+            });
+  if (entries.size() > k) entries.resize(k);
+}
+
+void CompletionList::SerializeToBytes(std::string &value) const {
+  PutVarint32(&value, capacity_);
+  PutVarint32(&value, items_.size());
+  for (const auto &item : items_) {
+    PutVarint32(&value, item.term.size());
+    value.append(item.term);
+    AppendFixed64(value, static_cast<uint64_t>(item.weight));
+    AppendFixed64(value, static_cast<uint64_t>(item.error));
+  }
+}
+
+bool CompletionList::Deserialize(const Slice &value) {
+  Slice input(value);
+  uint32_t count = 0;
+  items_.clear();
+  if (!GetVarint32(&input, &capacity_) || !GetVarint32(&input, &count)) {
+    return false;
+  }
+  for (uint32_t i = 0; i < count; i++) {
+    uint32_t size = 0;
+    if (!GetVarint32(&input, &size) ||
+        input.size() < size + 2 * sizeof(uint64_t)) {
+      items_.clear();
+      return false;
+    }
+    Item item;
+    item.term.assign(input.data(), size);
+    input.remove_prefix(size);
+    uint64_t weight = 0;
+    uint64_t error = 0;
+    RemoveFixed64(input, weight);
+    RemoveFixed64(input, error);
+    item.weight = static_cast<int64_t>(weight);
+    item.error = static_cast<int64_t>(error);
+    items_.push_back(item);
+  }
+  return true;
+}
+
+void CompletionList::MergeValue(const Slice *existing, const Slice &value,
+                                std::string &new_value) {
+  CompletionList list;
+  if (nullptr != existing) {
+    list.Deserialize(*existing);
+  }
+  CompletionList operand;
+  operand.Deserialize(value);
+  list.Merge(operand);
+  new_value.clear();
+  list.SerializeToBytes(new_value);
+}
+
+}  // namespace wwsearch
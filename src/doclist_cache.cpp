@@ -0,0 +1,90 @@
+/*
+ * Tencent is pleased to support the open source community by making wwsearch
+ * available.
+ *
+ * Copyright (C) 2018-present Tencent. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * https://opensource.org/licenses/Apache-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OF ANY KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+#include "doclist_cache.h"
+#include <functional>
+
+namespace wwsearch {
+
+DocListCache::DocListCache(size_t capacity_bytes, uint32_t min_doc_list_size,
+                           size_t shard_num)
+    : min_doc_list_size_(min_doc_list_size), hits_(0), misses_(0) {
+  if (0 == shard_num) shard_num = 1;
+  for (size_t i = 0; i < shard_num; i++) {
+    shards_.emplace_back(new Shard());
+  }
+  shard_capacity_bytes_ = capacity_bytes / shard_num;
+}
+
+DocListCache::Shard *DocListCache::GetShard(const std::string &key) {
+  return shards_[std::hash<std::string>()(key) % shards_.size()].get();
+}
+
+size_t DocListCache::Charge(const std::string &key,
+                            const DocListPtr &doc_list) {
+  // key is kept twice,in lru and index.
+  return 2 * key.size() + doc_list->size() + sizeof(std::string);
+}
+
+DocListCache::DocListPtr DocListCache::Get(const std::string &key) {
+  Shard *shard = GetShard(key);
+  std::lock_guard<std::mutex> guard(shard->mutex);
+  auto iter = shard->index.find(key);
+  if (iter == shard->index.end()) {
+    misses_++;
+    return nullptr;
+  }
+  shard->lru.splice(shard->lru.begin(), shard->lru, iter->second);
+  hits_++;
+  return iter->second->second;
+}
+
+void DocListCache::Put(const std::string &key, const DocListPtr &doc_list) {
+  size_t charge = Charge(key, doc_list);
+  if (charge > shard_capacity_bytes_) return;
+
+  Shard *shard = GetShard(key);
+  std::lock_guard<std::mutex> guard(shard->mutex);
+  auto iter = shard->index.find(key);
+  if (iter != shard->index.end()) {
+    // same key same content,just refresh it.
+    shard->lru.splice(shard->lru.begin(), shard->lru, iter->second);
+    return;
+  }
+  while (shard->usage_bytes + charge > shard_capacity_bytes_ &&
+         !shard->lru.empty()) {
+    auto &last = shard->lru.back();
+    shard->usage_bytes -= Charge(last.first, last.second);
+    shard->index.erase(last.first);
+    shard->lru.pop_back();
+  }
+  shard->lru.emplace_front(key, doc_list);
+  shard->index[key] = shard->lru.begin();
+  shard->usage_bytes += charge;
+}
+
+size_t DocListCache::UsageBytes() {
+  size_t usage_bytes = 0;
+  for (auto &shard : shards_) {
+    std::lock_guard<std::mutex> guard(shard->mutex);
+    usage_bytes += shard->usage_bytes;
+  }
+  return usage_bytes;
+}
+
+}  // namespace wwsearch
@@ -19,8 +19,11 @@
 #include "document_writer.h"
 #include <algorithm>
 #include "codec_doclist_impl.h"
+#include "completion_list.h"
 #include "logger.h"
+#include "numeric_trie.h"
 #include "stat_collector.h"
+#include "term_dictionary.h"
 #include "tokenizer.h"
 #include "utf8_suffixbuilder.h"
 #include "utils.h"
@@ -65,8 +68,12 @@ SearchStatus DocumentWriter::UpdateDocuments(
       tracer->Add(TracerType::kDocumentCount, documents.size());
     }
   }
+  DocFreqDeltaList doc_freq_deltas;
+  bool use_dictionary = this->config_->UseTermDictionary();
   if (status.OK()) {
-    status = WriteInvertedIndex(table, documents, *write_buffer, tracer);
+    status = WriteInvertedIndex(table, documents, *write_buffer,
+                                use_dictionary ? &doc_freq_deltas : nullptr,
+                                tracer);
   }
   if (status.OK()) {
     status = WriteDocValue(table, documents, *write_buffer, tracer);
@@ -75,7 +82,11 @@ SearchStatus DocumentWriter::UpdateDocuments(
     status = WriteTableMeta(table, documents, *write_buffer, tracer);
   }
   if (status.OK()) {
-    status = WriteDictionaryMeta(table, documents, *write_buffer, tracer);
+    status =
+        WriteDictionaryMeta(table, doc_freq_deltas, *write_buffer, tracer);
+  }
+  if (status.OK()) {
+    status = WriteCompletion(table, documents, *write_buffer, tracer);
   }
 
   // check write batch size limit
@@ -93,7 +104,7 @@ SearchStatus DocumentWriter::UpdateDocuments(
       gettimeofday(&begin, NULL);
 
       SearchLogDebug("");
-      status = vdb->FlushBuffer(write_buffer);
+      status = FlushWriteBuffer(table, write_buffer);
       SearchLogDebug("");
 
       gettimeofday(&end, NULL);
@@ -152,10 +163,36 @@ SearchStatus DocumentWriter::IngestInvertIndex(const TableID& table,
   }
 
   auto codec = this->config_->GetCodec();
-  for (const InvertIndexItem* item : indices.List()) {
-    std::string key;
+  std::list<InvertIndexItem*> items = indices.List();
+  std::vector<std::string> keys;
+  for (const InvertIndexItem* item : items) {
+    keys.emplace_back();
+    codec->EncodeInvertedKey(table, item->GetFieldID(), item->GetTerm(),
+                             keys.back());
+  }
+
+  // Docs may be ingested already,df only counts docs new to the term like
+  // WriteInvertedIndex does.
+  bool use_dictionary = this->config_->UseTermDictionary();
+  std::vector<std::string> old_doc_lists;
+  if (use_dictionary) {
+    std::vector<StorageColumnType> columns(keys.size(), kInvertedIndexColumn);
+    std::vector<SearchStatus> read_status;
+    vdb->MultiGet(columns, keys, old_doc_lists, read_status, nullptr);
+    for (size_t i = 0; i < read_status.size(); i++) {
+      if (read_status[i].OK()) continue;
+      if (!read_status[i].DocumentNotExist()) {
+        vdb->ReleaseWriteBuffer(write_buffer);
+        return read_status[i];
+      }
+      old_doc_lists[i].clear();
+    }
+  }
+
+  size_t i = 0;
+  for (const InvertIndexItem* item : items) {
+    const std::string& key = keys[i];
     std::string value;
-    codec->EncodeInvertedKey(table, item->GetFieldID(), item->GetTerm(), key);
     DocListWriterCodec* doc_list = codec->NewOrderDocListWriterCodec();
     assert(nullptr != doc_list);
     // in decrease order.
@@ -177,6 +214,18 @@ SearchStatus DocumentWriter::IngestInvertIndex(const TableID& table,
     if (!status.OK()) {
       SearchLogError("package buffer error") break;
     }
+    if (use_dictionary) {
+      uint32_t new_docs = CountNewDocs(*item, old_doc_lists[i]);
+      if (new_docs > 0) {
+        std::string doc_freq;
+        TermDictionary::EncodeDocFreq(new_docs, doc_freq);
+        status = write_buffer->Merge(kDictionaryColumn, key, doc_freq);
+        if (!status.OK()) {
+          SearchLogError("package buffer error") break;
+        }
+      }
+    }
+    i++;
   }
 
   // If success ,package to store_buffer if need.
@@ -185,7 +234,7 @@ SearchStatus DocumentWriter::IngestInvertIndex(const TableID& table,
       timeval begin, end;
       gettimeofday(&begin, NULL);
 
-      status = vdb->FlushBuffer(write_buffer);
+      status = FlushWriteBuffer(table, write_buffer);
 
       gettimeofday(&end, NULL);
       tracer->Set(TracerType::kDocumentWriterPutKvCount, 1);
@@ -205,6 +254,28 @@ SearchStatus DocumentWriter::IngestInvertIndex(const TableID& table,
   return status;
 }
 
+uint32_t DocumentWriter::CountNewDocs(const InvertIndexItem& item,
+                                      const std::string& old_doc_list) {
+  if (old_doc_list.empty()) return item.DocList().size();
+  Codec* codec = this->config_->GetCodec();
+  DocListReaderCodec* doc_list = codec->NewDocListReaderCodec(
+      old_doc_list.c_str(), old_doc_list.size(), item.GetFieldID());
+  uint32_t new_docs = 0;
+  // both in decrease order.
+  for (auto doc_id : item.DocList()) {
+    while (doc_list->DocID() != DocIdSetIterator::NO_MORE_DOCS &&
+           doc_list->DocID() > doc_id) {
+      doc_list->NextDoc();
+    }
+    if (doc_list->DocID() != doc_id ||
+        doc_list->State() != kDocumentStateOK) {
+      new_docs++;
+    }
+  }
+  codec->ReleaseDocListReaderCodec(doc_list);
+  return new_docs;
+}
+
 // Drop stored field of documents.
 SearchStatus DocumentWriter::WriteStoreFieldForDropTable(
     const TableID& table, WriteBuffer& write_buffer, SearchTracer* tracer) {
@@ -262,6 +333,20 @@ SearchStatus DocumentWriter::WriteTableMetaForDropTable(
   auto codec = this->config_->GetCodec();
   codec->EncodeMetaKey(table, meta_key);
   status = write_buffer.Delete(kMetaColumn, meta_key);
+  if (!status.OK()) {
+    return status;
+  }
+
+  // completion index
+  std::string begin_key;
+  codec->EncodeCompletionKey(table, 0, "", begin_key);
+  std::string end_key;
+  std::string max_term;
+  for (int i = 0; i < 256; ++i) {
+    max_term.append(1, char(255));
+  }
+  codec->EncodeCompletionKey(table, UINT8_MAX, max_term, end_key);
+  status = write_buffer.DeleteRange(kMetaColumn, begin_key, end_key);
   return status;
 }
 
@@ -269,6 +354,20 @@ SearchStatus DocumentWriter::WriteTableMetaForDropTable(
 SearchStatus DocumentWriter::WriteDictionaryMetaForDropTable(
     const TableID& table, WriteBuffer& write_buffer, SearchTracer* tracer) {
   SearchStatus status;
+  if (!this->config_->UseTermDictionary()) {
+    return status;
+  }
+  std::string begin_key;
+  auto codec = this->config_->GetCodec();
+  codec->EncodeInvertedKey(table, 0, "", begin_key);
+
+  std::string end_key;
+  std::string max_term;
+  for (int i = 0; i < 256; ++i) {
+    max_term.append(1, char(255));
+  }
+  codec->EncodeInvertedKey(table, UINT8_MAX, max_term, end_key);
+  status = write_buffer.DeleteRange(kDictionaryColumn, begin_key, end_key);
   return status;
 }
 
@@ -305,7 +404,7 @@ SearchStatus DocumentWriter::DropTable(const TableID& table,
 
   if (status.OK()) {
     if (nullptr == store_buffer) {
-      status = vdb->FlushBuffer(write_buffer);
+      status = FlushWriteBuffer(table, write_buffer);
     } else {
       *store_buffer = write_buffer->Data();
     }
@@ -454,7 +553,7 @@ SearchStatus DocumentWriter::AcquireNewSequence(
         if (nullptr != store_buffer) {
           *store_buffer = write_buffer->Data();
         } else {
-          status = vdb->FlushBuffer(write_buffer);
+          status = FlushWriteBuffer(table, write_buffer);
         }
       }
     } else {
@@ -617,7 +716,8 @@ SearchStatus DocumentWriter::WriteDocValue(
 // numeric-> doc list
 SearchStatus DocumentWriter::WriteInvertedIndex(
     const TableID& table, std::vector<DocumentUpdater*>& documents,
-    WriteBuffer& write_buffer, SearchTracer* tracer) {
+    WriteBuffer& write_buffer, DocFreqDeltaList* doc_freq_deltas,
+    SearchTracer* tracer) {
   SearchLogDebug("");
 
   // TODO: Optimize
@@ -663,6 +763,9 @@ SearchStatus DocumentWriter::WriteInvertedIndex(
             } else {
               // just as one term
               term_match[term] |= 1;
+              if (field->Flag().NumericTrie()) {
+                AddNumericTrieTerms(field, term, 1, term_match);
+              }
             }
           }
         }
@@ -699,6 +802,9 @@ SearchStatus DocumentWriter::WriteInvertedIndex(
             } while (builder.Next());
           } else {
             term_match[term] |= 1 << 1;
+            if (field->Flag().NumericTrie()) {
+              AddNumericTrieTerms(field, term, 1 << 1, term_match);
+            }
           }
         }
       }
@@ -736,6 +842,9 @@ SearchStatus DocumentWriter::WriteInvertedIndex(
             if (nullptr != tracer) {
               tracer->Add(TracerType::kRealInsertKeys, 1);
             }
+            if (nullptr != doc_freq_deltas) {
+              (*doc_freq_deltas)[key] += term.second == 1 ? 1 : -1;
+            }
             if (!status.OK()) {
               // some error happen.
               return status;
@@ -749,6 +858,34 @@ SearchStatus DocumentWriter::WriteInvertedIndex(
   return status;
 }
 
+SearchStatus DocumentWriter::FlushWriteBuffer(const TableID& table,
+                                              WriteBuffer* write_buffer) {
+  TableVersion* table_version = this->config_->GetTableVersion();
+  table_version->BeginWrite(table);
+  SearchStatus status = this->config_->VDB()->FlushBuffer(write_buffer);
+  table_version->EndWrite(table);
+  return status;
+}
+
+// Lower precision terms of numeric field,used by NumericRangeQuery.
+void DocumentWriter::AddNumericTrieTerms(IndexField* field,
+                                         const std::string& term,
+                                         unsigned char flag,
+                                         TermFlagPairList& term_match) {
+  if (field->FieldType() != kUint32IndexField &&
+      field->FieldType() != kUint64IndexField) {
+    return;
+  }
+  std::vector<std::string> trie_terms;
+  if (!NumericTrie::BuildLowerPrecisionTerms(
+          term, this->config_->GetNumericTriePrecisionStep(), trie_terms)) {
+    return;
+  }
+  for (const auto& trie_term : trie_terms) {
+    term_match[trie_term] |= flag;
+  }
+}
+
 // Not support
 SearchStatus DocumentWriter::WriteTableMeta(
     const TableID& table, std::vector<DocumentUpdater*>& documents,
@@ -768,12 +905,85 @@ SearchStatus DocumentWriter::WriteTableMeta(
   return status;
 }
 
-// Not support
+// Write doc frequency delta of terms,one merge per term of the batch.
 SearchStatus DocumentWriter::WriteDictionaryMeta(
+    const TableID& table, const DocFreqDeltaList& doc_freq_deltas,
+    WriteBuffer& write_buffer, SearchTracer* tracer) {
+  SearchStatus status;
+  for (const auto& delta : doc_freq_deltas) {
+    // add and delete of same term in batch
+    if (0 == delta.second) continue;
+    std::string value;
+    TermDictionary::EncodeDocFreq(delta.second, value);
+    status = write_buffer.Merge(kDictionaryColumn, delta.first, value);
+    if (!status.OK()) break;
+  }
+  return status;
+}
+
+// Write weight delta of terms to completion index of their prefixes.
+// Whole terms of completion field are counted,suffix terms are not.
+SearchStatus DocumentWriter::WriteCompletion(
     const TableID& table, std::vector<DocumentUpdater*>& documents,
     WriteBuffer& write_buffer, SearchTracer* tracer) {
-  // Do not need global dictionary now.
-  return SearchStatus();
+  SearchStatus status;
+  Codec* codec = this->config_->GetCodec();
+  uint32_t max_prefix_len = this->config_->GetMaxCompletionPrefixLen();
+  // completion key -> term -> delta
+  std::map<std::string, std::map<std::string, int64_t>> deltas;
+  for (auto du : documents) {
+    if (!du->Status().OK()) continue;
+    std::map<FieldID, std::map<std::string, int64_t>> field_terms;
+    auto collect = [&field_terms](Document& document, int64_t delta) {
+      for (auto field : document.Fields()) {
+        if (!field->Flag().Completion() ||
+            field->FieldType() != kStringIndexField) {
+          continue;
+        }
+        auto& terms = field_terms[field->ID()];
+        for (const auto& term : field->Terms()) {
+          if (!term.empty()) terms[term] += delta;
+        }
+      }
+    };
+    if (!du->Delete()) {
+      collect(du->New(), 1);
+    }
+    collect(du->Old(), -1);
+
+    for (const auto& field : field_terms) {
+      for (const auto& term : field.second) {
+        if (0 == term.second) continue;
+        // prefixes end at utf-8 code point boundary.
+        uint32_t prefix_len = 0;
+        for (size_t i = 1; i <= term.first.size(); i++) {
+          if (i < term.first.size() && (term.first[i] & 0xC0) == 0x80) {
+            continue;
+          }
+          if (++prefix_len > max_prefix_len) break;
+          std::string key;
+          codec->EncodeCompletionKey(table, field.first,
+                                     term.first.substr(0, i), key);
+          deltas[key][term.first] += term.second;
+        }
+      }
+    }
+  }
+
+  // keep twice of top k to bound Space-Saving error.
+  uint32_t capacity = 2 * this->config_->GetCompletionTopK();
+  for (const auto& prefix : deltas) {
+    CompletionList operand(capacity);
+    for (const auto& term : prefix.second) {
+      if (0 != term.second) operand.Append(term.first, term.second);
+    }
+    if (0 == operand.Size()) continue;
+    std::string value;
+    operand.SerializeToBytes(value);
+    status = write_buffer.Merge(kMetaColumn, prefix.first, value);
+    if (!status.OK()) break;
+  }
+  return status;
 }
 
 // segment text with tokenizer
@@ -0,0 +1,162 @@
+/*
+ * Tencent is pleased to support the open source community by making wwsearch
+ * available.
+ *
+ * Copyright (C) 2018-present Tencent. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * https://opensource.org/licenses/Apache-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OF ANY KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+#include "filter_pushdown.h"
+#include <set>
+#include "and_query.h"
+#include "bool_query.h"
+#include "logger.h"
+#include "numeric_range_query.h"
+#include "or_query.h"
+
+namespace wwsearch {
+
+FilterPushdown::~FilterPushdown() {
+  for (auto query : queries_) {
+    delete query;
+  }
+  queries_.clear();
+}
+
+Query *FilterPushdown::Plan(Query *query, std::vector<Filter *> *&filter,
+                            uint32_t min_match_filter_num) {
+  if (nullptr == filter || filter->empty()) return query;
+  // Some filter may not match,can not be required by inverted index.
+  if (0 != min_match_filter_num && min_match_filter_num < filter->size()) {
+    return query;
+  }
+
+  AndQuery *and_query = nullptr;
+  for (auto rule : *filter) {
+    bool answered = false;
+    Query *pushed = BuildQuery(rule, answered);
+    if (nullptr == pushed) {
+      remain_filter_.push_back(rule);
+      continue;
+    }
+    if (nullptr == and_query) {
+      and_query = new AndQuery();
+      queries_.push_back(and_query);
+      // keep user's query first,match field id come from it.
+      and_query->AddQuery(query);
+    }
+    and_query->AddQuery(pushed);
+    if (answered) {
+      pushed_filter_num_++;
+    } else {
+      remain_filter_.push_back(rule);
+    }
+  }
+  if (nullptr == and_query) return query;
+
+  SearchLogDebug("FilterPushdown pushed %u filters,remain %u",
+                 pushed_filter_num_, remain_filter_.size());
+  // all filters had been answered,skip reading docvalue.
+  filter = remain_filter_.empty() ? nullptr : &remain_filter_;
+  return and_query;
+}
+
+Query *FilterPushdown::BuildQuery(Filter *filter, bool &answered) {
+  IndexField &field = *filter->GetField();
+  if (!field.Flag().InvertIndex()) return nullptr;
+
+  if (nullptr != dynamic_cast<EqualFilter *>(filter)) {
+    if (Filter::CheckFieldTypeNumeric(field)) {
+      if (field.FieldType() == kUint32IndexField &&
+          field.NumericValue() > UINT32_MAX) {
+        return nullptr;
+      }
+      answered = true;
+      return BuildTermQuery(field, field.NumericValue());
+    }
+    if (Filter::CheckFieldTypeString(field) && !field.Flag().Tokenize() &&
+        !field.Flag().SuffixBuild() && !field.StringValue().empty()) {
+      std::string term = field.StringValue();
+      Tokenizer *tokenizer = config_->GetTokenizer();
+      if (nullptr != tokenizer) {
+        tokenizer->ToLowerCase(term);
+      }
+      if (term != field.StringValue()) return nullptr;
+      answered = false;
+      Query *query = new BooleanQuery(field.ID(), term);
+      queries_.push_back(query);
+      return query;
+    }
+    return nullptr;
+  }
+
+  if (nullptr != dynamic_cast<InNumericListFilter *>(filter)) {
+    if (!Filter::CheckFieldTypeNumeric(field)) return nullptr;
+    std::set<uint64_t> values;
+    for (auto value : field.NumericList()) {
+      // uint32 field never match bigger value.
+      if (field.FieldType() == kUint32IndexField && value > UINT32_MAX) {
+        continue;
+      }
+      values.insert(value);
+    }
+    if (values.empty()) return nullptr;
+    answered = true;
+    if (values.size() == 1) {
+      return BuildTermQuery(field, *values.begin());
+    }
+    OrQuery *or_query = new OrQuery();
+    queries_.push_back(or_query);
+    for (auto value : values) {
+      or_query->AddQuery(BuildTermQuery(field, value));
+    }
+    return or_query;
+  }
+
+  RangeFilter *range_filter = dynamic_cast<RangeFilter *>(filter);
+  if (nullptr != range_filter) {
+    if (!Filter::CheckFieldTypeNumeric(field) || !field.Flag().NumericTrie() ||
+        range_filter->Begin() > range_filter->End()) {
+      return nullptr;
+    }
+    Query *query = nullptr;
+    if (field.FieldType() == kUint32IndexField) {
+      if (range_filter->Begin() > UINT32_MAX) return nullptr;
+      uint64_t end = std::min<uint64_t>(range_filter->End(), UINT32_MAX);
+      query = new NumericRangeQuery(
+          field.ID(), static_cast<uint32_t>(range_filter->Begin()),
+          static_cast<uint32_t>(end));
+    } else {
+      query = new NumericRangeQuery(field.ID(), range_filter->Begin(),
+                                    range_filter->End());
+    }
+    queries_.push_back(query);
+    answered = true;
+    return query;
+  }
+  return nullptr;
+}
+
+Query *FilterPushdown::BuildTermQuery(const IndexField &field,
+                                      uint64_t value) {
+  Query *query = nullptr;
+  if (field.FieldType() == kUint32IndexField) {
+    query = new BooleanQuery(field.ID(), static_cast<uint32_t>(value));
+  } else {
+    query = new BooleanQuery(field.ID(), value);
+  }
+  queries_.push_back(query);
+  return query;
+}
+
+}  // namespace wwsearch
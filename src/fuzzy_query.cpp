@@ -0,0 +1,39 @@
+/*
+ * Tencent is pleased to support the open source community by making wwsearch
+ * available.
+ *
+ * Copyright (C) 2018-present Tencent. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * https://opensource.org/licenses/Apache-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OF ANY KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+#include "fuzzy_query.h"
+#include <algorithm>
+#include "fuzzy_weight.h"
+
+namespace wwsearch {
+
+FuzzyQuery::FuzzyQuery(FieldID field_id, const std::string &term,
+                       uint32_t max_edits, uint32_t max_expansion_terms)
+    : field_id_(field_id),
+      match_term_(term),
+      max_edits_(std::min<uint32_t>(max_edits, 2)),
+      max_expansion_terms_(max_expansion_terms) {}
+
+FuzzyQuery::~FuzzyQuery() {}
+
+Weight *FuzzyQuery::CreateWeight(SearchContext *context, bool needs_scores,
+                                 double boost) {
+  return new FuzzyWeight(this);
+}
+
+}  // namespace wwsearch
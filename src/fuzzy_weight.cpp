@@ -0,0 +1,167 @@
+/*
+ * Tencent is pleased to support the open source community by making wwsearch
+ * available.
+ *
+ * Copyright (C) 2018-present Tencent. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * https://opensource.org/licenses/Apache-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OF ANY KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+#include "fuzzy_weight.h"
+#include <algorithm>
+#include <tuple>
+#include "logger.h"
+#include "prefix_scorer.h"
+#include "storage_type.h"
+#include "term_dictionary.h"
+#include "utils.h"
+
+namespace wwsearch {
+
+FuzzyWeight::FuzzyWeight(FuzzyQuery *query)
+    : Weight(query, "FuzzyWeight"), codec_(nullptr) {}
+
+FuzzyWeight::~FuzzyWeight() {}
+
+// Terms of field are walked in order,automaton tells the next term which
+// may match,so iterator seeks over terms which can not match.
+Scorer *FuzzyWeight::GetScorer(SearchContext *context) {
+  FuzzyQuery *fuzzy_query = reinterpret_cast<FuzzyQuery *>(this->GetQuery());
+  codec_ = context->GetConfig()->GetCodec();
+
+  std::vector<std::pair<uint32_t, std::string>> terms;
+  LevenshteinAutomaton automaton(fuzzy_query->MatchTerm(),
+                                 fuzzy_query->MaxEdits());
+  if (context->GetConfig()->UseTermDictionary()) {
+    MatchByDictionary(context, automaton, terms);
+  } else {
+    MatchByInvertedIndex(context, automaton, terms);
+  }
+
+  expansion_.Init(context, fuzzy_query->GetFieldID());
+  for (auto &term : terms) {
+    expansion_.TakeDocList(term.second);
+  }
+  return new PrefixScorer(this, expansion_.Finish());
+}
+
+void FuzzyWeight::MatchByInvertedIndex(
+    SearchContext *context, LevenshteinAutomaton &automaton,
+    std::vector<std::pair<uint32_t, std::string>> &terms) {
+  FuzzyQuery *fuzzy_query = reinterpret_cast<FuzzyQuery *>(this->GetQuery());
+  size_t max_terms = fuzzy_query->MaxExpansionTerms();
+  auto closest = [](const std::pair<uint32_t, std::string> &a,
+                    const std::pair<uint32_t, std::string> &b) {
+    return a.first < b.first;
+  };
+  std::string field_key;
+  codec_->EncodeInvertedKey(context->Table(), fuzzy_query->GetFieldID(), "",
+                            field_key);
+  VirtualDBReadOption options;
+  options.snapshot_ = context->GetSnapshot();
+  options.iterate_upper_bound_ = PrefixSuccessor(field_key);
+  auto iterator = context->VDB()->NewIterator(kInvertedIndexColumn, &options);
+
+  uint32_t seek_count = 0;
+  iterator->Seek(field_key);
+  while (iterator->Valid() && !context->Interrupted()) {
+    Slice key = iterator->key();
+    if (!HasPrefix(key.data(), key.size(), field_key)) break;
+    std::string term(key.data() + field_key.size(),
+                     key.size() - field_key.size());
+    uint32_t distance = 0;
+    std::string seek;
+    if (automaton.Accept(term, distance, seek)) {
+      Slice value = iterator->value();
+      terms.emplace_back(distance, std::string(value.data(), value.size()));
+      // keep memory bounded,drop farthest terms.
+      if (terms.size() >= 2 * max_terms + 1) {
+        std::stable_sort(terms.begin(), terms.end(), closest);
+        terms.resize(max_terms);
+      }
+      iterator->Next();
+      continue;
+    }
+    if (seek.empty()) break;
+    seek_count++;
+    iterator->Seek(field_key + seek);
+  }
+  delete iterator;
+  if (terms.size() > max_terms) {
+    std::stable_sort(terms.begin(), terms.end(), closest);
+    terms.resize(max_terms);
+  }
+  SearchLogDebug("fuzzy term=%s match=%u seek=%u",
+                 fuzzy_query->MatchTerm().c_str(), terms.size(), seek_count);
+}
+
+// Only doc lists of kept terms are read.Frequent term wins a tie of
+// distance,as it is more likely what user means.
+void FuzzyWeight::MatchByDictionary(
+    SearchContext *context, LevenshteinAutomaton &automaton,
+    std::vector<std::pair<uint32_t, std::string>> &terms) {
+  FuzzyQuery *fuzzy_query = reinterpret_cast<FuzzyQuery *>(this->GetQuery());
+  size_t max_terms = fuzzy_query->MaxExpansionTerms();
+  // distance,negative doc frequency,term
+  typedef std::tuple<uint32_t, int64_t, std::string> Candidate;
+  std::vector<Candidate> candidates;
+  TermDictionary dictionary(context, fuzzy_query->GetFieldID());
+  uint32_t seek_count = 0;
+  dictionary.Seek("");
+  while (dictionary.Valid() && !context->Interrupted()) {
+    uint32_t distance = 0;
+    std::string seek;
+    if (automaton.Accept(dictionary.Term(), distance, seek)) {
+      candidates.emplace_back(distance,
+                              -static_cast<int64_t>(dictionary.DocFreq()),
+                              dictionary.Term());
+      // keep memory bounded,drop farthest terms.
+      if (candidates.size() >= 2 * max_terms + 1) {
+        std::sort(candidates.begin(), candidates.end());
+        candidates.resize(max_terms);
+      }
+      dictionary.Next();
+      continue;
+    }
+    if (seek.empty()) break;
+    seek_count++;
+    dictionary.Seek(seek);
+  }
+  std::sort(candidates.begin(), candidates.end());
+  if (candidates.size() > max_terms) {
+    candidates.resize(max_terms);
+  }
+
+  std::vector<std::string> match_terms;
+  for (auto &candidate : candidates) {
+    match_terms.push_back(std::get<2>(candidate));
+  }
+  std::vector<std::string> values;
+  SearchStatus status = dictionary.ReadDocLists(match_terms, values);
+  if (!status.OK()) {
+    context->Status() = status;
+    return;
+  }
+  for (size_t i = 0; i < values.size(); i++) {
+    if (values[i].empty()) continue;
+    terms.emplace_back(std::get<0>(candidates[i]), std::string());
+    terms.back().second.swap(values[i]);
+  }
+  SearchLogDebug("fuzzy term=%s match=%u seek=%u by dictionary",
+                 fuzzy_query->MatchTerm().c_str(), terms.size(), seek_count);
+}
+
+BulkScorer *FuzzyWeight::GetBulkScorer(SearchContext *context) {
+  return nullptr;
+}
+
+}  // namespace wwsearch
@@ -21,7 +21,13 @@
 namespace wwsearch {
 
 IndexConfig::IndexConfig()
-    : codec_(nullptr), vdb_(nullptr), tokenizer_(nullptr) {
+    : codec_(nullptr),
+      vdb_(nullptr),
+      tokenizer_(nullptr),
+      query_result_cache_(nullptr),
+      doclist_cache_(nullptr),
+      query_thread_pool_(nullptr),
+      search_executor_(nullptr) {
   this->log_level_ = kSearchLogLevelError;
 }
 
@@ -51,4 +57,36 @@ bool IndexConfig::SetTokenizer(Tokenizer* tokenizer) {
 
 Tokenizer* IndexConfig::GetTokenizer() { return this->tokenizer_; }
 
+bool IndexConfig::SetQueryResultCache(QueryResultCache* query_result_cache) {
+  this->query_result_cache_ = query_result_cache;
+  return true;
+}
+
+QueryResultCache* IndexConfig::GetQueryResultCache() {
+  return this->query_result_cache_;
+}
+
+bool IndexConfig::SetDocListCache(DocListCache* doclist_cache) {
+  this->doclist_cache_ = doclist_cache;
+  return true;
+}
+
+DocListCache* IndexConfig::GetDocListCache() { return this->doclist_cache_; }
+
+bool IndexConfig::SetQueryThreadPool(ThreadPool* query_thread_pool) {
+  this->query_thread_pool_ = query_thread_pool;
+  return true;
+}
+
+ThreadPool* IndexConfig::GetQueryThreadPool() {
+  return this->query_thread_pool_;
+}
+
+bool IndexConfig::SetSearchExecutor(ThreadPool* search_executor) {
+  this->search_executor_ = search_executor;
+  return true;
+}
+
+ThreadPool* IndexConfig::GetSearchExecutor() { return this->search_executor_; }
+
 }  // namespace wwsearch
@@ -77,6 +77,26 @@ bool IndexFieldFlag::NotStoreInvertTerm() const {
   return this->flag_ & kNotStoreInvertTermFieldFlag;
 }
 
+// Set numeric trie.
+// If open,numeric field will also index lower precision terms
+// so that NumericRangeQuery could cover a range with few terms.
+void IndexFieldFlag::SetNumericTrie() { this->flag_ |= kNumericTrieFieldFlag; }
+
+// If open?
+bool IndexFieldFlag::NumericTrie() const {
+  return this->flag_ & kNumericTrieFieldFlag;
+}
+
+// Set completion.
+// If open,terms of string field will be kept in completion index of
+// their prefixes,see Searcher::Complete.
+void IndexFieldFlag::SetCompletion() { this->flag_ |= kCompletionFieldFlag; }
+
+// If open?
+bool IndexFieldFlag::Completion() const {
+  return this->flag_ & kCompletionFieldFlag;
+}
+
 IndexField::IndexField()
     : field_id_(-1),
       field_type_(kIndexFieldUnknowType),
@@ -369,7 +369,7 @@ SearchStatus IndexWriter::DeleteTableData(TableID &table,
   }
   delete iterator;
   if (status.OK()) {
-    status = db->FlushBuffer(write_buffer);
+    status = document_writer_.FlushWriteBuffer(table, write_buffer);
   }
   db->ReleaseWriteBuffer(write_buffer);
   if (status.OK()) {
@@ -431,4 +431,13 @@ bool IndexWriter::DropTable(const TableID &table, std::string *store_buffer,
   return status.OK();
 }
 
+SearchStatus IndexWriter::FlushStoreBuffer(const TableID &table,
+                                           const std::string &store_buffer) {
+  VirtualDB *db = config_->VDB();
+  WriteBuffer *write_buffer = db->NewWriteBuffer(&store_buffer);
+  SearchStatus status = document_writer_.FlushWriteBuffer(table, write_buffer);
+  db->ReleaseWriteBuffer(write_buffer);
+  return status;
+}
+
 }  // namespace wwsearch
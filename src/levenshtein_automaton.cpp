@@ -0,0 +1,155 @@
+/*
+ * Tencent is pleased to support the open source community by making wwsearch
+ * available.
+ *
+ * Copyright (C) 2018-present Tencent. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * https://opensource.org/licenses/Apache-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OF ANY KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+#include "levenshtein_automaton.h"
+#include <algorithm>
+#include <iterator>
+#include "core.h"
+#include "unchecked.h"
+
+namespace wwsearch {
+
+static const uint32_t kMaxCodePoint = 0x10ffff;
+
+LevenshteinAutomaton::LevenshteinAutomaton(const std::string &term,
+                                           uint32_t max_edits)
+    : max_edits_(max_edits) {
+  if (!DecodeUTF8(term, term_)) {
+    // not utf-8,match bytes.
+    term_.assign(term.begin(), term.end());
+  }
+  alphabet_ = term_;
+  std::sort(alphabet_.begin(), alphabet_.end());
+  alphabet_.erase(std::unique(alphabet_.begin(), alphabet_.end()),
+                  alphabet_.end());
+}
+
+void LevenshteinAutomaton::Start(State &state) {
+  state.resize(term_.size() + 1);
+  for (size_t i = 0; i < state.size(); i++) {
+    state[i] = i;
+  }
+}
+
+void LevenshteinAutomaton::Step(const State &state, uint32_t code_point,
+                                State &next) {
+  next.resize(state.size());
+  next[0] = state[0] + 1;
+  for (size_t i = 1; i < state.size(); i++) {
+    uint32_t cost = (term_[i - 1] == code_point) ? 0 : 1;
+    next[i] = std::min(std::min(state[i] + 1, next[i - 1] + 1),
+                       state[i - 1] + cost);
+  }
+}
+
+bool LevenshteinAutomaton::CanMatch(const State &state) {
+  return *std::min_element(state.begin(), state.end()) <= max_edits_;
+}
+
+bool LevenshteinAutomaton::NextCodePoint(const State &state, uint32_t after,
+                                         uint32_t &next) {
+  State step;
+  // Code point out of term,all of them share one state.
+  Step(state, kMaxCodePoint + 1, step);
+  if (CanMatch(step)) {
+    if (after >= kMaxCodePoint) return false;
+    next = after + 1;
+    // skip surrogates,they are not valid in utf-8.
+    if (next >= 0xd800 && next <= 0xdfff) next = 0xe000;
+    return true;
+  }
+  auto iter = std::upper_bound(alphabet_.begin(), alphabet_.end(), after);
+  for (; iter != alphabet_.end(); ++iter) {
+    Step(state, *iter, step);
+    if (CanMatch(step)) {
+      next = *iter;
+      return true;
+    }
+  }
+  return false;
+}
+
+bool LevenshteinAutomaton::Accept(const std::string &term, uint32_t &distance,
+                                  std::string &seek) {
+  std::vector<uint32_t> code_points;
+  if (!DecodeUTF8(term, code_points)) {
+    // skip invalid term.
+    seek = term;
+    seek.push_back('\0');
+    return false;
+  }
+
+  std::vector<State> states(1);
+  Start(states[0]);
+  size_t dead = code_points.size();
+  for (size_t i = 0; i < code_points.size(); i++) {
+    states.emplace_back();
+    Step(states[i], code_points[i], states[i + 1]);
+    if (!CanMatch(states[i + 1])) {
+      dead = i;
+      break;
+    }
+  }
+
+  if (dead == code_points.size()) {
+    distance = Distance(states.back());
+    if (distance <= max_edits_) return true;
+    // longer term may match,next term is the one after.
+    seek = term;
+    seek.push_back('\0');
+    return false;
+  }
+
+  // Replace first char that kills the state with a greater one,backtrack
+  // if there is none.
+  for (size_t i = dead + 1; i > 0; i--) {
+    uint32_t next = 0;
+    if (NextCodePoint(states[i - 1], code_points[i - 1], next)) {
+      EncodeUTF8(code_points, i - 1, seek);
+      utf8::unchecked::append(next, std::back_inserter(seek));
+      return false;
+    }
+  }
+  seek.clear();
+  return false;
+}
+
+bool LevenshteinAutomaton::DecodeUTF8(const std::string &str,
+                                      std::vector<uint32_t> &code_points) {
+  code_points.clear();
+  auto it = str.begin();
+  while (it != str.end()) {
+    uint32_t code_point = 0;
+    if (utf8::internal::UTF8_OK !=
+        utf8::internal::validate_next(it, str.end(), code_point)) {
+      return false;
+    }
+    code_points.push_back(code_point);
+  }
+  return true;
+}
+
+void LevenshteinAutomaton::EncodeUTF8(
+    const std::vector<uint32_t> &code_points, size_t size, std::string &str) {
+  str.clear();
+  for (size_t i = 0; i < size && i < code_points.size(); i++) {
+    utf8::unchecked::append(code_points[i], std::back_inserter(str));
+  }
+}
+
+}  // namespace wwsearch
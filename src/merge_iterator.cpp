@@ -17,6 +17,7 @@
  */
 
 #include "merge_iterator.h"
+#include <algorithm>
 #include "logger.h"
 
 namespace wwsearch {
@@ -29,66 +30,72 @@ DocumentID MergeIterator::Advance(DocumentID target) {
   return InnderNextDoc(true, target);
 }
 
+// upper bound of intersection size.
 CostType MergeIterator::Cost() {
-  // not support now
-  assert(false);
-  return 0;
+  if (this->sub_iterator_.empty()) return 0;
+  CostType cost = this->sub_iterator_.front()->Cost();
+  for (auto iterator : this->sub_iterator_) {
+    cost = std::min(cost, iterator->Cost());
+  }
+  return cost;
+}
+
+void MergeIterator::FinishAddIterator() {
+  if (!sorted_) {
+    std::stable_sort(sub_iterator_.begin(), sub_iterator_.end(),
+                     [](DocIdSetIterator* a, DocIdSetIterator* b) {
+                       return a->Cost() < b->Cost();
+                     });
+    sorted_ = true;
+  }
+  curr_ = Advance(MAX_DOCID);
 }
 
 DocumentID MergeIterator::InnderNextDoc(bool use_advance, DocumentID target) {
-  for (auto iterator : this->sub_iterator_) {
-    if (use_advance)
-      iterator->Advance(target);
-    else
-      iterator->NextDoc();
+  if (this->sub_iterator_.empty()) {
+    curr_ = NO_MORE_DOCS;
+    return curr_;
+  }
+
+  DocIdSetIterator* lead = this->sub_iterator_.front();
+  DocumentID candidate = NO_MORE_DOCS;
+  if (use_advance) {
+    candidate = lead->Advance(target);
+    for (size_t i = 1; i < this->sub_iterator_.size(); i++) {
+      this->sub_iterator_[i]->Advance(target);
+    }
+  } else {
+    candidate = lead->NextDoc();
   }
 
-  for (;;) {
-    bool first = true, retry = false;
-    // find min id
-    DocumentID min = NO_MORE_DOCS;
-    FieldID new_field_id = 0;
-    for (auto iterator : this->sub_iterator_) {
-      DocumentID docid = iterator->DocID();
-      FieldID fieldid = iterator->FieldId();
-      SearchLogDebug(
-          "InnderNextDoc docid=%llu, min=%llu, filedid=%u, new_field_id=%u",
-          docid, min, fieldid, new_field_id);
-      if (first) {
-        min = docid;
-        new_field_id = fieldid;
-        first = false;
-      } else if (docid < min) {
-        min = docid;
-        new_field_id = fieldid;
-        retry = true;
-      } else if (docid > min) {
-        retry = true;
+  while (candidate != NO_MORE_DOCS) {
+    DocumentID next = candidate;
+    for (size_t i = 1; i < this->sub_iterator_.size(); i++) {
+      DocIdSetIterator* iterator = this->sub_iterator_[i];
+      if (iterator->DocID() > candidate) {
+        iterator->Advance(candidate);
+      }
+      if (iterator->DocID() < candidate) {
+        next = iterator->DocID();
+        break;
       }
     }
 
     // all head id is same
-    if (!retry) {
-      curr_ = min;
-      field_id_ = new_field_id;
-      SearchLogDebug("Finally break, InnderNextDoc curr=%llu field_id=%u",
-                     curr_, field_id_);
-      break;
-    }
+    if (next == candidate) break;
 
-    SearchLogDebug("merge Advance min=%llu", min);
-    // advance all
-    for (auto iterator : this->sub_iterator_) {
-      SearchLogDebug("before merge Advance docid=%llu, min=%llu",
-                     iterator->DocID(), min);
-      if (iterator->DocID() > min) {
-        iterator->Advance(min);
-        SearchLogDebug("after merge Advance docid=%llu, min=%llu",
-                       iterator->DocID(), min);
-      }
+    SearchLogDebug("merge Advance candidate=%llu next=%llu", candidate, next);
+    if (next == NO_MORE_DOCS) {
+      candidate = NO_MORE_DOCS;
+      break;
     }
+    candidate = lead->Advance(next);
   }
 
+  curr_ = candidate;
+  field_id_ = first_iterator_->FieldId();
+  SearchLogDebug("Finally break, InnderNextDoc curr=%llu field_id=%u", curr_,
+                 field_id_);
   return curr_;
 }
 
@@ -0,0 +1,96 @@
+/*
+ * Tencent is pleased to support the open source community by making wwsearch
+ * available.
+ *
+ * Copyright (C) 2018-present Tencent. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * https://opensource.org/licenses/Apache-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OF ANY KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+#include "min_should_match_iterator.h"
+#include <algorithm>
+#include <functional>
+#include "logger.h"
+
+namespace wwsearch {
+
+DocumentID MinShouldMatchIterator::DocID() { return curr_; }
+
+DocumentID MinShouldMatchIterator::NextDoc() {
+  if (NO_MORE_DOCS == curr_) return NO_MORE_DOCS;
+  for (auto iterator : sub_iterator_) {
+    if (iterator->DocID() == curr_) iterator->NextDoc();
+  }
+  return NextMatch();
+}
+
+DocumentID MinShouldMatchIterator::Advance(DocumentID target) {
+  for (auto iterator : sub_iterator_) {
+    if (iterator->DocID() > target) iterator->Advance(target);
+  }
+  return NextMatch();
+}
+
+CostType MinShouldMatchIterator::Cost() {
+  if (sub_iterator_.size() < min_should_match_) return 0;
+  std::vector<CostType> costs;
+  for (auto iterator : sub_iterator_) {
+    costs.push_back(iterator->Cost());
+  }
+  std::sort(costs.begin(), costs.end());
+  CostType cost = 0;
+  for (size_t i = 0; i < costs.size() - min_should_match_ + 1; i++) {
+    cost += costs[i];
+  }
+  return cost;
+}
+
+void MinShouldMatchIterator::FinishAddIterator() {
+  for (auto iterator : sub_iterator_) {
+    iterator->Advance(MAX_DOCID);
+  }
+  NextMatch();
+}
+
+DocumentID MinShouldMatchIterator::NextMatch() {
+  curr_ = NO_MORE_DOCS;
+  if (sub_iterator_.size() < min_should_match_) return curr_;
+  for (;;) {
+    heads_.clear();
+    for (auto iterator : sub_iterator_) {
+      heads_.push_back(iterator->DocID());
+    }
+    std::nth_element(heads_.begin(), heads_.begin() + min_should_match_ - 1,
+                     heads_.end(), std::greater<DocumentID>());
+    DocumentID candidate = heads_[min_should_match_ - 1];
+    if (NO_MORE_DOCS == candidate) break;
+
+    // fewer than k iterators could match documents after candidate.
+    uint32_t match = 0;
+    for (auto iterator : sub_iterator_) {
+      if (iterator->DocID() > candidate) iterator->Advance(candidate);
+      if (iterator->DocID() == candidate) {
+        if (0 == match) field_id_ = iterator->FieldId();
+        match++;
+      }
+    }
+    if (match >= min_should_match_) {
+      curr_ = candidate;
+      break;
+    }
+    SearchLogDebug("MinShouldMatch skip candidate=%llu match=%u", candidate,
+                   match);
+  }
+  return curr_;
+}
+
+}  // namespace wwsearch
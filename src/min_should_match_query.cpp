@@ -0,0 +1,32 @@
+/*
+ * Tencent is pleased to support the open source community by making wwsearch
+ * available.
+ *
+ * Copyright (C) 2018-present Tencent. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * https://opensource.org/licenses/Apache-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OF ANY KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+#include "min_should_match_query.h"
+#include "min_should_match_weight.h"
+namespace wwsearch {
+
+Weight* MinShouldMatchQuery::CreateWeight(SearchContext* context,
+                                          bool needs_scores, double boost) {
+  MinShouldMatchWeight* weight = new MinShouldMatchWeight(this);
+  for (auto q : this->sub_query_) {
+    weight->AddWeight(q->CreateWeight(context, needs_scores, 0));
+  }
+  return weight;
+}
+
+}  // namespace wwsearch
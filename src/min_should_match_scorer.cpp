@@ -0,0 +1,35 @@
+/*
+ * Tencent is pleased to support the open source community by making wwsearch
+ * available.
+ *
+ * Copyright (C) 2018-present Tencent. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * https://opensource.org/licenses/Apache-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OF ANY KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+#include "min_should_match_scorer.h"
+
+namespace wwsearch {
+
+DocumentID MinShouldMatchScorer::DocID() {
+  assert(false);
+  return 0;
+}
+
+double MinShouldMatchScorer::Score() { return 0; }
+
+DocIdSetIterator &MinShouldMatchScorer::Iterator() {
+  this->iterator_.FinishAddIterator();
+  return iterator_;
+}
+
+}  // namespace wwsearch
@@ -0,0 +1,51 @@
+/*
+ * Tencent is pleased to support the open source community by making wwsearch
+ * available.
+ *
+ * Copyright (C) 2018-present Tencent. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * https://opensource.org/licenses/Apache-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OF ANY KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+#include "numeric_range_query.h"
+#include "numeric_range_weight.h"
+
+namespace wwsearch {
+
+NumericRangeQuery::NumericRangeQuery(FieldID field_id, uint32_t lower,
+                                     uint32_t upper, bool trie_indexed,
+                                     uint32_t max_expansion_terms)
+    : field_id_(field_id),
+      value_type_(kUint32IndexField),
+      lower_(lower),
+      upper_(upper),
+      trie_indexed_(trie_indexed),
+      max_expansion_terms_(max_expansion_terms) {}
+
+NumericRangeQuery::NumericRangeQuery(FieldID field_id, uint64_t lower,
+                                     uint64_t upper, bool trie_indexed,
+                                     uint32_t max_expansion_terms)
+    : field_id_(field_id),
+      value_type_(kUint64IndexField),
+      lower_(lower),
+      upper_(upper),
+      trie_indexed_(trie_indexed),
+      max_expansion_terms_(max_expansion_terms) {}
+
+NumericRangeQuery::~NumericRangeQuery() {}
+
+Weight *NumericRangeQuery::CreateWeight(SearchContext *context,
+                                        bool needs_scores, double boost) {
+  return new NumericRangeWeight(this);
+}
+
+}  // namespace wwsearch
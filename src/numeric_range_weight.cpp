@@ -0,0 +1,156 @@
+/*
+ * Tencent is pleased to support the open source community by making wwsearch
+ * available.
+ *
+ * Copyright (C) 2018-present Tencent. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * https://opensource.org/licenses/Apache-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OF ANY KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+#include "numeric_range_weight.h"
+#include "coding.h"
+#include "logger.h"
+#include "numeric_range_scorer.h"
+#include "numeric_trie.h"
+#include "search_status.h"
+#include "storage_type.h"
+#include "utils.h"
+
+namespace wwsearch {
+
+NumericRangeWeight::NumericRangeWeight(NumericRangeQuery *query)
+    : Weight(query, "NumericRangeWeight") {}
+
+NumericRangeWeight::~NumericRangeWeight() {}
+
+Scorer *NumericRangeWeight::GetScorer(SearchContext *context) {
+  NumericRangeQuery *query =
+      reinterpret_cast<NumericRangeQuery *>(this->GetQuery());
+  expansion_.Init(context, query->GetFieldID());
+
+  SearchStatus status;
+  if (query->TrieIndexed()) {
+    status = ReadTrieTerms(context, query);
+  } else {
+    status = ScanTerms(context, query);
+  }
+  if (!status.OK()) {
+    if (status.GetCode() != kReachMaxExpansionTermsLimit) {
+      context->Status() = status;
+      return nullptr;
+    }
+    // partial terms,let caller know.
+    context->Status() = status;
+  }
+  return new NumericRangeScorer(this, expansion_.Finish());
+}
+
+SearchStatus NumericRangeWeight::ReadTrieTerms(SearchContext *context,
+                                               NumericRangeQuery *query) {
+  SearchStatus status;
+  Codec *codec = context->GetConfig()->GetCodec();
+  uint32_t bits = query->ValueType() == kUint32IndexField ? 32 : 64;
+  std::vector<std::string> terms;
+  if (!NumericTrie::SplitRange(
+          query->Lower(), query->Upper(), bits,
+          context->GetConfig()->GetNumericTriePrecisionStep(),
+          query->MaxExpansionTerms(), terms)) {
+    char buf[128];
+    snprintf(buf, sizeof(buf),
+             "NumericRangeWeight MaxExpansionTerms(%u) reached",
+             query->MaxExpansionTerms());
+    SearchLogError("%s", buf);
+    status.SetStatus(kReachMaxExpansionTermsLimit, buf);
+  }
+
+  std::vector<StorageColumnType> columns;
+  std::vector<std::string> keys;
+  std::vector<SearchStatus> read_status;
+  for (const auto &term : terms) {
+    std::string key;
+    codec->EncodeInvertedKey(context->Table(), query->GetFieldID(), term, key);
+    keys.push_back(key);
+    columns.push_back(kInvertedIndexColumn);
+  }
+  SearchLogDebug("NumericRangeWeight [%llu,%llu] split into %u terms",
+                 query->Lower(), query->Upper(), keys.size());
+  if (keys.empty()) return status;
+
+  std::vector<std::string> values;
+  context->VDB()->MultiGet(columns, keys, values, read_status,
+                           context->GetSnapshot());
+  assert(keys.size() == read_status.size());
+  for (size_t i = 0; i < read_status.size(); i++) {
+    if (!read_status[i].OK()) {
+      // document not exist is ok,just skip it.
+      if (!read_status[i].DocumentNotExist()) {
+        return read_status[i];
+      }
+      continue;
+    }
+    if (values[i].empty()) continue;
+    expansion_.TakeDocList(values[i]);
+  }
+  return status;
+}
+
+SearchStatus NumericRangeWeight::ScanTerms(SearchContext *context,
+                                           NumericRangeQuery *query) {
+  SearchStatus status;
+  if (query->Lower() > query->Upper()) return status;
+  Codec *codec = context->GetConfig()->GetCodec();
+  std::string lower_term, upper_term;
+  uint32_t bits = query->ValueType() == kUint32IndexField ? 32 : 64;
+  NumericTrie::EncodeTerm(query->Lower(), 0, bits, lower_term);
+  NumericTrie::EncodeTerm(query->Upper(), 0, bits, upper_term);
+
+  std::string lower_key, upper_key;
+  codec->EncodeInvertedKey(context->Table(), query->GetFieldID(), lower_term,
+                           lower_key);
+  codec->EncodeInvertedKey(context->Table(), query->GetFieldID(), upper_term,
+                           upper_key);
+
+  VirtualDBReadOption options;
+  options.snapshot_ = context->GetSnapshot();
+  options.iterate_upper_bound_ = PrefixSuccessor(upper_key);
+  auto iterator = context->VDB()->NewIterator(kInvertedIndexColumn, &options);
+  uint32_t term_count = 0;
+  for (iterator->Seek(lower_key); iterator->Valid(); iterator->Next()) {
+    // skip lower precision terms, which have different size.
+    if (iterator->key().size() != lower_key.size()) continue;
+    if (memcmp(iterator->key().data(), upper_key.c_str(), upper_key.size()) > 0)
+      break;
+    if (term_count >= query->MaxExpansionTerms()) {
+      char buf[128];
+      snprintf(buf, sizeof(buf),
+               "NumericRangeWeight MaxExpansionTerms(%u) reached",
+               query->MaxExpansionTerms());
+      SearchLogError("%s", buf);
+      status.SetStatus(kReachMaxExpansionTermsLimit, buf);
+      break;
+    }
+    term_count++;
+    if (iterator->value().empty()) continue;
+    expansion_.AddDocList(iterator->value());
+  }
+  if (status.OK()) {
+    status = iterator->status();
+  }
+  delete iterator;
+  return status;
+}
+
+BulkScorer *NumericRangeWeight::GetBulkScorer(SearchContext *context) {
+  return nullptr;
+}
+
+}  // namespace wwsearch
@@ -0,0 +1,109 @@
+/*
+ * Tencent is pleased to support the open source community by making wwsearch
+ * available.
+ *
+ * Copyright (C) 2018-present Tencent. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * https://opensource.org/licenses/Apache-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OF ANY KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+#include "numeric_trie.h"
+#include "coding.h"
+
+namespace wwsearch {
+
+void NumericTrie::EncodeTerm(uint64_t value, uint32_t shift, uint32_t bits,
+                             std::string& term) {
+  if (shift != 0) {
+    AppendFixed8(term, static_cast<uint8_t>(shift));
+  }
+  if (bits == 32) {
+    AppendFixed32(term, static_cast<uint32_t>(value >> shift));
+  } else {
+    AppendFixed64(term, value >> shift);
+  }
+}
+
+bool NumericTrie::BuildLowerPrecisionTerms(const std::string& term,
+                                           uint32_t precision_step,
+                                           std::vector<std::string>& terms) {
+  uint32_t bits = term.size() * 8;
+  if ((bits != 32 && bits != 64) || precision_step == 0) return false;
+  Slice slice(term);
+  uint64_t value;
+  if (bits == 32) {
+    uint32_t value32;
+    RemoveFixed32(slice, value32);
+    value = value32;
+  } else {
+    RemoveFixed64(slice, value);
+  }
+  for (uint32_t shift = precision_step; shift < bits; shift += precision_step) {
+    std::string lower_term;
+    EncodeTerm(value, shift, bits, lower_term);
+    terms.push_back(lower_term);
+  }
+  return true;
+}
+
+// Same as lucene's NumericUtils.splitRange.
+// At each level, the head and tail which could not be covered by lower
+// precision terms are added, the middle part goes to next level.
+bool NumericTrie::SplitRange(uint64_t lower, uint64_t upper, uint32_t bits,
+                             uint32_t precision_step, size_t max_terms,
+                             std::vector<std::string>& terms) {
+  if (lower > upper) return true;
+  if (precision_step == 0) precision_step = bits;
+  for (uint32_t shift = 0;; shift += precision_step) {
+    if (shift + precision_step >= bits) {
+      return AddRange(lower, upper, shift, bits, max_terms, terms);
+    }
+    uint64_t diff = 1ULL << (shift + precision_step);
+    uint64_t mask = ((1ULL << precision_step) - 1) << shift;
+    bool has_lower = (lower & mask) != 0;
+    bool has_upper = (upper & mask) != mask;
+    uint64_t next_lower = (lower + (has_lower ? diff : 0)) & ~mask;
+    uint64_t next_upper = (upper - (has_upper ? diff : 0)) & ~mask;
+    bool lower_wrapped = next_lower < lower;
+    bool upper_wrapped = next_upper > upper;
+    if (lower_wrapped || upper_wrapped || next_lower > next_upper) {
+      return AddRange(lower, upper, shift, bits, max_terms, terms);
+    }
+    if (has_lower &&
+        !AddRange(lower, lower | mask, shift, bits, max_terms, terms)) {
+      return false;
+    }
+    if (has_upper &&
+        !AddRange(upper & ~mask, upper, shift, bits, max_terms, terms)) {
+      return false;
+    }
+    lower = next_lower;
+    upper = next_upper;
+  }
+  return true;
+}
+
+bool NumericTrie::AddRange(uint64_t min, uint64_t max, uint32_t shift,
+                           uint32_t bits, size_t max_terms,
+                           std::vector<std::string>& terms) {
+  uint64_t end = max >> shift;
+  for (uint64_t i = min >> shift;; i++) {
+    if (terms.size() >= max_terms) return false;
+    std::string term;
+    EncodeTerm(i << shift, shift, bits, term);
+    terms.push_back(term);
+    if (i == end) break;
+  }
+  return true;
+}
+
+}  // namespace wwsearch
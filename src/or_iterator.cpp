@@ -37,10 +37,13 @@ DocumentID OrIterator::Advance(DocumentID target) {
   return InnderNextDoc(true, target);
 }
 
+// upper bound of union size.
 CostType OrIterator::Cost() {
-  // not support now
-  assert(false);
-  return 0;
+  CostType cost = 0;
+  for (auto iterator : this->sub_iterator_) {
+    cost += iterator->Cost();
+  }
+  return cost;
 }
 
 DocumentID OrIterator::InnderNextDoc(bool use_advance, DocumentID target) {
@@ -25,6 +25,16 @@ DocumentID OrScorer::DocID() {}
 double OrScorer::Score() { return 0; }
 
 DocIdSetIterator &OrScorer::Iterator() {
+  if (term_at_a_time_) {
+    if (!buffer_ready_) {
+      for (auto s : sub_scorer_) {
+        buffer_iterator_.AddSubIterator(&(s->Iterator()));
+      }
+      buffer_iterator_.FinishAddIterator();
+      buffer_ready_ = true;
+    }
+    return buffer_iterator_;
+  }
   iterator_.FinishAddIterator();
   return iterator_;
 }
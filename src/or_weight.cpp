@@ -18,6 +18,7 @@
 
 #include "or_weight.h"
 #include "or_scorer.h"
+#include "logger.h"
 
 namespace wwsearch {
 
@@ -32,6 +33,14 @@ Scorer* OrWeight::GetScorer(SearchContext* context) {
     }
     scorer->AddScorer(s);
   }
+
+  IndexConfig* config = context->GetConfig();
+  if (scorer->SubScorerSize() > config->GetMaxOrHeapIterators() ||
+      scorer->Iterator().Cost() >= config->GetMinOrTermAtATimeCost()) {
+    SearchLogDebug("OrWeight use term at a time, sub scorer size=%u",
+                   scorer->SubScorerSize());
+    scorer->UseTermAtATime();
+  }
   return scorer;
 }
 
@@ -22,10 +22,12 @@
 namespace wwsearch {
 
 PrefixQuery::PrefixQuery(FieldID field_id, const std::string &term,
-                         uint32_t max_doc_list_size)
+                         uint32_t max_doc_list_size,
+                         uint32_t max_expansion_terms)
     : field_id_(field_id),
       match_term_(term),
-      max_doc_list_size_(max_doc_list_size) {}
+      max_doc_list_size_(max_doc_list_size),
+      max_expansion_terms_(max_expansion_terms) {}
 
 PrefixQuery::~PrefixQuery() {}
 
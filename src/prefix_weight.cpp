@@ -17,106 +17,148 @@
  */
 
 #include "prefix_weight.h"
+#include <algorithm>
 #include "func_scope_guard.h"
 #include "header.h"
 #include "or_iterator.h"
 #include "prefix_scorer.h"
 #include "search_status.h"
 #include "storage_type.h"
+#include "term_dictionary.h"
 #include "utils.h"
 
 namespace wwsearch {
 
 PrefixWeight::PrefixWeight(PrefixQuery *query)
-    : Weight(query, "PrefixWeight"), or_iterator(nullptr), codec_(nullptr) {}
+    : Weight(query, "PrefixWeight"), codec_(nullptr) {}
 
-PrefixWeight::~PrefixWeight() {
-  if (nullptr != or_iterator) {
-    delete or_iterator;
-    or_iterator = nullptr;
-  }
+PrefixWeight::~PrefixWeight() {}
 
-  for (auto it : this->iterators) {
-    assert(nullptr != codec_);
-    codec_->ReleaseDocListReaderCodec(it);
+// prefix query,to find limit prefix term
+Scorer *PrefixWeight::GetScorer(SearchContext *context) {
+  PrefixQuery *prefix_query = reinterpret_cast<PrefixQuery *>(this->GetQuery());
+  codec_ = context->GetConfig()->GetCodec();
+  expansion_.Init(context, prefix_query->GetFieldID());
+  if (context->GetConfig()->UseTermDictionary()) {
+    ExpandByDictionary(context);
+  } else {
+    ExpandByInvertedIndex(context);
   }
-  this->iterators.clear();
+  return new PrefixScorer(this, expansion_.Finish());
 }
 
-// prefix query,to find limit prefix term
-Scorer *PrefixWeight::GetScorer(SearchContext *context) {
-  Codec *codec = context->GetConfig()->GetCodec();
+void PrefixWeight::ExpandByInvertedIndex(SearchContext *context) {
   PrefixQuery *prefix_query = reinterpret_cast<PrefixQuery *>(this->GetQuery());
-  auto db = context->VDB();
-  {
-    VirtualDBReadOption options;
-    options.snapshot_ = context->GetSnapshot();
-    auto iterator = db->NewIterator(kInvertedIndexColumn, &options);
-    std::string prefix_key;
-    codec->EncodeInvertedKey(context->Table(), prefix_query->GetFieldID(),
-                             prefix_query->MatchTerm(), prefix_key);
-
-    SearchLogDebug(
-        "PrefixWeight::GetScorer prefix_key(tableID=%s, FieldID=%u, "
-        "MatchTerm=%s), prefix key size=%d",
-        context->Table().PrintToStr().c_str(), prefix_query->GetFieldID(),
-        prefix_query->MatchTerm().c_str(), prefix_key.size());
-    uint32_t total_doc_list_size = 0;
-    for (iterator->Seek(prefix_key); iterator->Valid(); iterator->Next()) {
-      // reach max limit
-      if (total_doc_list_size >= prefix_query->MaxDocListSize()) {
-        char buf[128];
-        snprintf(buf, sizeof(buf),
-                 "PrefixWeight::GetScorer default MaxDocListSize(%lu), "
-                 "total_doc_list_size(%lu)",
-                 prefix_query->MaxDocListSize(), total_doc_list_size);
-        SearchLogError("%s", buf);
-        context->Status().SetStatus(kReachMaxDocListSizeLimit, buf);
-        break;
-      }
-
-      // have same prefix ?
-      if (iterator->key().size() < prefix_key.size() ||
-          0 != memcmp(prefix_key.c_str(), iterator->key().data(),
-                      prefix_key.size())) {
-        SearchLogDebug(
-            "PrefixWeight::GetScorer not same prefix, break "
-            "prefix_key(tableID=%s, FieldID=%u, "
-            "MatchTerm=%s) size=%d, "
-            "iterator->key size=%d",
-            context->Table().PrintToStr().c_str(), prefix_query->GetFieldID(),
-            prefix_query->MatchTerm().c_str(), prefix_key.size(),
-            iterator->key().size());
-        for (int i = 0; i < prefix_key.size(); ++i) {
-          SearchLogDebug("%d , %c , %c\n", i, prefix_key[i],
-                         *(iterator->key().data() + i));
-        }
-        break;
-      }
-      total_doc_list_size += iterator->value().size();
-      this->values_.emplace_back(iterator->value().data(),
-                                 iterator->value().size());
+  std::string prefix_key;
+  codec_->EncodeInvertedKey(context->Table(), prefix_query->GetFieldID(),
+                            prefix_query->MatchTerm(), prefix_key);
+  VirtualDBReadOption options;
+  options.snapshot_ = context->GetSnapshot();
+  options.iterate_upper_bound_ = PrefixSuccessor(prefix_key);
+  auto iterator = context->VDB()->NewIterator(kInvertedIndexColumn, &options);
+
+  SearchLogDebug(
+      "PrefixWeight::GetScorer prefix_key(tableID=%s, FieldID=%u, "
+      "MatchTerm=%s), prefix key size=%d",
+      context->Table().PrintToStr().c_str(), prefix_query->GetFieldID(),
+      prefix_query->MatchTerm().c_str(), prefix_key.size());
+  uint32_t total_doc_list_size = 0;
+  uint32_t term_count = 0;
+  for (iterator->Seek(prefix_key); iterator->Valid(); iterator->Next()) {
+    if (context->Interrupted()) {
+      SearchLogError("PrefixWeight::GetScorer interrupted,term_count(%u)",
+                     term_count);
+      break;
     }
-    delete iterator;
+
+    // reach max limit
+    if (ReachDocListSizeLimit(context, total_doc_list_size)) break;
+
+    if (term_count >= prefix_query->MaxExpansionTerms()) {
+      char buf[128];
+      snprintf(buf, sizeof(buf),
+               "PrefixWeight::GetScorer MaxExpansionTerms(%u) reached",
+               prefix_query->MaxExpansionTerms());
+      SearchLogError("%s", buf);
+      context->Status().SetStatus(kReachMaxExpansionTermsLimit, buf);
+      break;
+    }
+
+    Slice key = iterator->key();
+    if (!HasPrefix(key.data(), key.size(), prefix_key)) break;
+
+    Slice value = iterator->value();
+    total_doc_list_size += value.size();
+    term_count++;
+    expansion_.AddDocList(value);
   }
+  delete iterator;
+  SearchLogDebug("match prefix term number=%u\n", term_count);
+}
 
-  SearchLogDebug("match prefix term number=%d\n", this->values_.size());
+// Terms and limits are decided before any doc list is read,then doc lists
+// are read in batch of GetMaxOrHeapIterators.
+void PrefixWeight::ExpandByDictionary(SearchContext *context) {
+  PrefixQuery *prefix_query = reinterpret_cast<PrefixQuery *>(this->GetQuery());
+  const std::string &prefix = prefix_query->MatchTerm();
+  std::vector<std::string> terms;
+  TermDictionary dictionary(context, prefix_query->GetFieldID());
+  for (dictionary.Seek(prefix); dictionary.Valid(); dictionary.Next()) {
+    if (context->Interrupted()) break;
+    const std::string &term = dictionary.Term();
+    if (!HasPrefix(term.c_str(), term.size(), prefix)) break;
+    if (terms.size() >= prefix_query->MaxExpansionTerms()) {
+      char buf[128];
+      snprintf(buf, sizeof(buf),
+               "PrefixWeight::GetScorer MaxExpansionTerms(%u) reached",
+               prefix_query->MaxExpansionTerms());
+      SearchLogError("%s", buf);
+      context->Status().SetStatus(kReachMaxExpansionTermsLimit, buf);
+      break;
+    }
+    terms.push_back(term);
+  }
 
-  // Note: may return empty values_ because no one doc match.
-  or_iterator = new OrIterator();
-  for (auto &value : values_) {
-    DocListReaderCodec *doc_lists = codec->NewDocListReaderCodec(
-        value.c_str(), value.size(), prefix_query->GetFieldID());
-    this->iterators.push_back(doc_lists);
-    or_iterator->AddSubIterator(doc_lists);
+  size_t batch = std::max<size_t>(
+      1, context->GetConfig()->GetMaxOrHeapIterators());
+  uint32_t total_doc_list_size = 0;
+  for (size_t i = 0; i < terms.size(); i += batch) {
+    std::vector<std::string> batch_terms(
+        terms.begin() + i, terms.begin() + std::min(i + batch, terms.size()));
+    std::vector<std::string> values;
+    SearchStatus status = dictionary.ReadDocLists(batch_terms, values);
+    if (!status.OK()) {
+      context->Status() = status;
+      break;
+    }
+    bool reach_limit = false;
+    for (auto &value : values) {
+      if (value.empty()) continue;
+      reach_limit = ReachDocListSizeLimit(context, total_doc_list_size);
+      if (reach_limit) break;
+      total_doc_list_size += value.size();
+      expansion_.AddDocList(value);
+    }
+    if (reach_limit || context->Interrupted()) break;
+  }
+  SearchLogDebug("match prefix term number=%u by dictionary\n",
+                 terms.size());
+}
 
-    SearchLogDebug("doclist/value[%d %s]\n", value.size(),
-                   DebugInvertedValueByReader(codec, value).c_str());
+bool PrefixWeight::ReachDocListSizeLimit(SearchContext *context,
+                                         uint32_t total_doc_list_size) {
+  PrefixQuery *prefix_query = reinterpret_cast<PrefixQuery *>(this->GetQuery());
+  if (total_doc_list_size < prefix_query->MaxDocListSize()) {
+    return false;
   }
-  or_iterator->FinishAddIterator();
-  codec_ = codec;
-  PrefixScorer *scorer = new PrefixScorer(this, or_iterator);
-  return scorer;
+  char buf[128];
+  snprintf(buf, sizeof(buf),
+           "PrefixWeight::GetScorer default MaxDocListSize(%lu), "
+           "total_doc_list_size(%lu)",
+           prefix_query->MaxDocListSize(), total_doc_list_size);
+  SearchLogError("%s", buf);
+  context->Status().SetStatus(kReachMaxDocListSizeLimit, buf);
+  return true;
 }
 
 BulkScorer *PrefixWeight::GetBulkScorer(SearchContext *context) {
@@ -0,0 +1,113 @@
+/*
+ * Tencent is pleased to support the open source community by making wwsearch
+ * available.
+ *
+ * Copyright (C) 2018-present Tencent. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * https://opensource.org/licenses/Apache-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OF ANY KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+#include "query_result_cache.h"
+#include "coding.h"
+
+namespace wwsearch {
+
+QueryResultCache::QueryResultCache(size_t capacity_bytes)
+    : capacity_bytes_(capacity_bytes), usage_bytes_(0), hits_(0), misses_(0) {}
+
+std::string QueryResultCache::EntryKey(const TableID &table,
+                                       const std::string &key) {
+  std::string entry_key;
+  AppendFixed8(entry_key, table.business_type);
+  AppendFixed64(entry_key, table.partition_set);
+  entry_key.append(key);
+  return entry_key;
+}
+
+bool QueryResultCache::Get(const TableID &table, const std::string &key,
+                           uint64_t version, std::list<DocumentID> &docs,
+                           uint32_t *match_total_cnt) {
+  std::string entry_key = EntryKey(table, key);
+  std::lock_guard<std::mutex> guard(mutex_);
+  auto iter = index_.find(entry_key);
+  if (iter == index_.end()) {
+    misses_++;
+    return false;
+  }
+  // written after cached,drop it.
+  if (iter->second->version != version) {
+    Erase(iter->second);
+    misses_++;
+    return false;
+  }
+
+  lru_.splice(lru_.begin(), lru_, iter->second);
+  const Entry &entry = lru_.front();
+  docs.insert(docs.begin(), entry.docs.begin(), entry.docs.end());
+  if (nullptr != match_total_cnt) {
+    *match_total_cnt += entry.match_total_cnt;
+  }
+  hits_++;
+  return true;
+}
+
+void QueryResultCache::Put(const TableID &table, const std::string &key,
+                           uint64_t version,
+                           const std::list<DocumentID> &docs,
+                           uint32_t match_total_cnt) {
+  Entry entry;
+  entry.key = EntryKey(table, key);
+  entry.version = version;
+  entry.docs.assign(docs.begin(), docs.end());
+  entry.match_total_cnt = match_total_cnt;
+  // key is kept twice,in entry and index.
+  entry.charge = sizeof(Entry) + 2 * entry.key.size() +
+                 entry.docs.size() * sizeof(DocumentID);
+  if (entry.charge > capacity_bytes_) return;
+
+  std::lock_guard<std::mutex> guard(mutex_);
+  auto iter = index_.find(entry.key);
+  if (iter != index_.end()) {
+    Erase(iter->second);
+  }
+  while (usage_bytes_ + entry.charge > capacity_bytes_ && !lru_.empty()) {
+    Erase(std::prev(lru_.end()));
+  }
+  usage_bytes_ += entry.charge;
+  lru_.push_front(std::move(entry));
+  index_[lru_.front().key] = lru_.begin();
+}
+
+void QueryResultCache::Erase(std::list<Entry>::iterator iter) {
+  usage_bytes_ -= iter->charge;
+  index_.erase(iter->key);
+  lru_.erase(iter);
+}
+
+void QueryResultCache::Clear() {
+  std::lock_guard<std::mutex> guard(mutex_);
+  index_.clear();
+  lru_.clear();
+  usage_bytes_ = 0;
+}
+
+size_t QueryResultCache::UsageBytes() {
+  std::lock_guard<std::mutex> guard(mutex_);
+  return usage_bytes_;
+}
+
+size_t QueryResultCache::Size() {
+  std::lock_guard<std::mutex> guard(mutex_);
+  return lru_.size();
+}
+
+}  // namespace wwsearch
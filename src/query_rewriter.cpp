@@ -0,0 +1,362 @@
+/*
+ * Tencent is pleased to support the open source community by making wwsearch
+ * available.
+ *
+ * Copyright (C) 2018-present Tencent. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * https://opensource.org/licenses/Apache-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OF ANY KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+#include "query_rewriter.h"
+#include <algorithm>
+#include <set>
+#include "and_not_query.h"
+#include "and_query.h"
+#include "bool_query.h"
+#include "coding.h"
+#include "fuzzy_query.h"
+#include "logger.h"
+#include "min_should_match_query.h"
+#include "numeric_range_query.h"
+#include "or_query.h"
+#include "prefix_query.h"
+#include "term_dictionary.h"
+#include "utils.h"
+#include "wildcard_query.h"
+
+namespace wwsearch {
+
+// Estimated cost rank of query,smaller is cheaper.
+enum kQueryCostRank {
+  kEmptyQueryCost = 0,
+  kTermQueryCost = 1,
+  kRangeQueryCost = 2,
+  kCompoundQueryCost = 3,
+  kPrefixQueryCost = 4,
+  kUnknownQueryCost = 5,
+};
+
+QueryRewriter::~QueryRewriter() {
+  for (auto query : queries_) {
+    delete query;
+  }
+  queries_.clear();
+}
+
+Query *QueryRewriter::Rewrite(Query *query) {
+  std::string key;
+  uint32_t cost;
+  return InnerRewrite(query, key, cost);
+}
+
+bool QueryRewriter::EncodeQueryKey(Query *query, std::string &key) {
+  const std::vector<Query *> *sub_query = nullptr;
+  if (nullptr != dynamic_cast<AndQuery *>(query)) {
+    AppendFixed8(key, 'A');
+    sub_query = &dynamic_cast<AndQuery *>(query)->SubQuery();
+  } else if (nullptr != dynamic_cast<OrQuery *>(query)) {
+    AppendFixed8(key, 'O');
+    sub_query = &dynamic_cast<OrQuery *>(query)->SubQuery();
+  } else if (nullptr != dynamic_cast<MinShouldMatchQuery *>(query)) {
+    MinShouldMatchQuery *min_should_match_query =
+        dynamic_cast<MinShouldMatchQuery *>(query);
+    AppendFixed8(key, 'M');
+    AppendFixed32(key, min_should_match_query->MinShouldMatch());
+    sub_query = &min_should_match_query->SubQuery();
+  } else if (nullptr != dynamic_cast<AndNotQuery *>(query)) {
+    AndNotQuery *and_not_query = dynamic_cast<AndNotQuery *>(query);
+    AppendFixed8(key, 'N');
+    return EncodeQueryList(and_not_query->RequiredQuery(), key) &&
+           EncodeQueryList(and_not_query->ExcludedQuery(), key);
+  } else {
+    return EncodeLeafKey(query, key);
+  }
+
+  return EncodeQueryList(*sub_query, key);
+}
+
+bool QueryRewriter::EncodeQueryList(const std::vector<Query *> &sub_query,
+                                    std::string &key) {
+  AppendFixed32(key, sub_query.size());
+  for (auto sub : sub_query) {
+    std::string sub_key;
+    if (!EncodeQueryKey(sub, sub_key)) return false;
+    AppendFixed32(key, sub_key.size());
+    key.append(sub_key);
+  }
+  return true;
+}
+
+bool QueryRewriter::EncodeLeafKey(Query *query, std::string &key) {
+  if (nullptr != dynamic_cast<BooleanQuery *>(query)) {
+    BooleanQuery *term_query = dynamic_cast<BooleanQuery *>(query);
+    AppendFixed8(key, 'T');
+    AppendFixed8(key, term_query->GetFieldID());
+    AppendFixed8(key, term_query->ValueType());
+    if (term_query->IsTerm()) {
+      key.append(term_query->MatchTerm());
+    } else {
+      AppendFixed64(key, term_query->MatchNumeric());
+    }
+    return true;
+  }
+
+  if (nullptr != dynamic_cast<NumericRangeQuery *>(query)) {
+    NumericRangeQuery *range_query = dynamic_cast<NumericRangeQuery *>(query);
+    AppendFixed8(key, 'R');
+    AppendFixed8(key, range_query->GetFieldID());
+    AppendFixed8(key, range_query->ValueType());
+    AppendFixed8(key, range_query->TrieIndexed());
+    AppendFixed32(key, range_query->MaxExpansionTerms());
+    AppendFixed64(key, range_query->Lower());
+    AppendFixed64(key, range_query->Upper());
+    return true;
+  }
+
+  if (nullptr != dynamic_cast<FuzzyQuery *>(query)) {
+    FuzzyQuery *fuzzy_query = dynamic_cast<FuzzyQuery *>(query);
+    AppendFixed8(key, 'F');
+    AppendFixed8(key, fuzzy_query->GetFieldID());
+    AppendFixed8(key, fuzzy_query->MaxEdits());
+    AppendFixed32(key, fuzzy_query->MaxExpansionTerms());
+    key.append(fuzzy_query->MatchTerm());
+    return true;
+  }
+
+  if (nullptr != dynamic_cast<WildcardQuery *>(query)) {
+    WildcardQuery *wildcard_query = dynamic_cast<WildcardQuery *>(query);
+    AppendFixed8(key, 'W');
+    AppendFixed8(key, wildcard_query->GetFieldID());
+    AppendFixed32(key, wildcard_query->MaxExpansionTerms());
+    key.append(wildcard_query->Pattern());
+    return true;
+  }
+
+  if (nullptr != dynamic_cast<PrefixQuery *>(query)) {
+    PrefixQuery *prefix_query = dynamic_cast<PrefixQuery *>(query);
+    AppendFixed8(key, 'P');
+    AppendFixed8(key, prefix_query->GetFieldID());
+    AppendFixed32(key, prefix_query->MaxDocListSize());
+    AppendFixed32(key, prefix_query->MaxExpansionTerms());
+    key.append(prefix_query->MatchTerm());
+    return true;
+  }
+  return false;
+}
+
+Query *QueryRewriter::InnerRewrite(Query *query, std::string &key,
+                                   uint32_t &cost) {
+  auto iter = rewritten_.find(query);
+  if (iter != rewritten_.end()) {
+    key = iter->second.key;
+    cost = iter->second.cost;
+    return iter->second.query;
+  }
+
+  Query *rewrite_query = query;
+  key.clear();
+  cost = kUnknownQueryCost;
+  if (nullptr != dynamic_cast<AndQuery *>(query)) {
+    rewrite_query = RewriteBoolean(
+        true, dynamic_cast<AndQuery *>(query)->SubQuery(), key, cost);
+  } else if (nullptr != dynamic_cast<OrQuery *>(query)) {
+    rewrite_query = RewriteBoolean(
+        false, dynamic_cast<OrQuery *>(query)->SubQuery(), key, cost);
+  } else if (nullptr != dynamic_cast<PrefixQuery *>(query)) {
+    rewrite_query =
+        RewritePrefix(dynamic_cast<PrefixQuery *>(query), key, cost);
+  } else if (nullptr != dynamic_cast<BooleanQuery *>(query)) {
+    EncodeLeafKey(query, key);
+    cost = kTermQueryCost;
+  } else if (nullptr != dynamic_cast<NumericRangeQuery *>(query)) {
+    EncodeLeafKey(query, key);
+    cost = kRangeQueryCost;
+  }
+
+  RewriteResult result{rewrite_query, key, cost};
+  rewritten_[query] = result;
+  rewritten_[rewrite_query] = result;
+  return rewrite_query;
+}
+
+Query *QueryRewriter::RewriteBoolean(bool is_and,
+                                     const std::vector<Query *> &sub_query,
+                                     std::string &key, uint32_t &cost) {
+  struct SubQueryItem {
+    Query *query;
+    std::string key;
+    uint32_t cost;
+    uint64_t doc_freq;
+  };
+  std::vector<SubQueryItem> items;
+  std::set<std::string> keys;
+  auto add_item = [&](Query *query, const std::string &sub_key,
+                      uint32_t sub_cost) {
+    // unknown query could not be deduped.
+    if (!sub_key.empty() && !keys.insert(sub_key).second) {
+      SearchLogDebug("QueryRewriter drop duplicate sub query");
+      return;
+    }
+    items.push_back({query, sub_key, sub_cost, UINT64_MAX});
+  };
+
+  for (auto query : sub_query) {
+    std::string sub_key;
+    uint32_t sub_cost;
+    Query *rewrite_query = InnerRewrite(query, sub_key, sub_cost);
+    // flatten same type sub query,they had been rewritten.
+    const std::vector<Query *> *children = nullptr;
+    if (is_and && nullptr != dynamic_cast<AndQuery *>(rewrite_query)) {
+      children = &dynamic_cast<AndQuery *>(rewrite_query)->SubQuery();
+    } else if (!is_and && nullptr != dynamic_cast<OrQuery *>(rewrite_query)) {
+      children = &dynamic_cast<OrQuery *>(rewrite_query)->SubQuery();
+    }
+    if (nullptr == children) {
+      add_item(rewrite_query, sub_key, sub_cost);
+      continue;
+    }
+    for (auto child : *children) {
+      InnerRewrite(child, sub_key, sub_cost);
+      add_item(child, sub_key, sub_cost);
+    }
+  }
+
+  if (items.size() == 1) {
+    key = items.front().key;
+    cost = items.front().cost;
+    return items.front().query;
+  }
+
+  // Match field id come from the first sub query,keep it first and sort
+  // others by cost. Empty sub query goes first,And matches nothing then.
+  if (is_and && items.size() > 1) {
+    for (size_t i = 1; i < items.size(); i++) {
+      if (items[i].cost == kTermQueryCost) {
+        items[i].doc_freq = EstimateDocFreq(items[i].query);
+      }
+    }
+    std::stable_sort(items.begin() + 1, items.end(),
+                     [](const SubQueryItem &a, const SubQueryItem &b) {
+                       return a.cost != b.cost ? a.cost < b.cost
+                                               : a.doc_freq < b.doc_freq;
+                     });
+    if (items[1].cost == kEmptyQueryCost) {
+      std::swap(items[0], items[1]);
+    }
+  }
+
+  // key is built from sorted sub keys,because And/Or is commutative.
+  key.clear();
+  AppendFixed8(key, is_and ? 'A' : 'O');
+  bool all_known = true;
+  for (const auto &sub_key : keys) {
+    AppendFixed32(key, sub_key.size());
+    key.append(sub_key);
+  }
+  for (const auto &item : items) {
+    if (item.key.empty()) all_known = false;
+  }
+  if (!all_known) key.clear();
+
+  // And is empty if any sub query is empty,Or is empty if all are empty.
+  cost = kCompoundQueryCost;
+  if (!items.empty()) {
+    bool all_empty = true, any_empty = false;
+    for (const auto &item : items) {
+      if (item.cost == kEmptyQueryCost) {
+        any_empty = true;
+      } else {
+        all_empty = false;
+      }
+    }
+    if ((is_and && any_empty) || (!is_and && all_empty)) {
+      cost = kEmptyQueryCost;
+    }
+  }
+
+  if (is_and) {
+    AndQuery *and_query = new AndQuery();
+    queries_.push_back(and_query);
+    for (const auto &item : items) and_query->AddQuery(item.query);
+    return and_query;
+  }
+  OrQuery *or_query = new OrQuery();
+  queries_.push_back(or_query);
+  for (const auto &item : items) or_query->AddQuery(item.query);
+  return or_query;
+}
+
+// Probe at most two terms,prefix which only match one term is same as
+// term query.
+Query *QueryRewriter::RewritePrefix(PrefixQuery *query, std::string &key,
+                                    uint32_t &cost) {
+  EncodeLeafKey(query, key);
+  cost = kPrefixQueryCost;
+  if (query->MaxExpansionTerms() == 0) return query;
+
+  Codec *codec = context_->GetConfig()->GetCodec();
+  std::string prefix_key;
+  codec->EncodeInvertedKey(context_->Table(), query->GetFieldID(),
+                           query->MatchTerm(), prefix_key);
+  VirtualDBReadOption options;
+  options.snapshot_ = context_->GetSnapshot();
+  options.iterate_upper_bound_ = PrefixSuccessor(prefix_key);
+  auto iterator = context_->VDB()->NewIterator(kInvertedIndexColumn, &options);
+  std::string first_key;
+  size_t term_count = 0;
+  for (iterator->Seek(prefix_key); iterator->Valid() && term_count < 2;
+       iterator->Next()) {
+    Slice key = iterator->key();
+    if (!HasPrefix(key.data(), key.size(), prefix_key)) break;
+    if (0 == term_count) {
+      first_key.assign(key.data(), key.size());
+    }
+    term_count++;
+  }
+  bool ok = iterator->status().OK();
+  delete iterator;
+  // let weight handle error.
+  if (!ok) return query;
+
+  if (0 == term_count) {
+    cost = kEmptyQueryCost;
+    return query;
+  }
+  if (1 == term_count) {
+    uint8_t business_type, field_id;
+    uint64_t partition_set;
+    std::string term;
+    if (!codec->DecodeInvertedKey(Slice(first_key), &business_type,
+                                  &partition_set, &field_id, &term)) {
+      return query;
+    }
+    BooleanQuery *term_query = new BooleanQuery(query->GetFieldID(), term);
+    queries_.push_back(term_query);
+    SearchLogDebug("QueryRewriter prefix %s -> term %s",
+                   query->MatchTerm().c_str(), term.c_str());
+    return InnerRewrite(term_query, key, cost);
+  }
+  return query;
+}
+
+// One dictionary Get per term,only sub queries of And are probed.
+uint64_t QueryRewriter::EstimateDocFreq(Query *query) {
+  if (!context_->GetConfig()->UseTermDictionary()) return UINT64_MAX;
+  BooleanQuery *term_query = dynamic_cast<BooleanQuery *>(query);
+  if (nullptr == term_query || !term_query->IsTerm()) return UINT64_MAX;
+  uint64_t doc_freq = 0;
+  SearchStatus status = TermDictionary::GetDocFreq(
+      context_, term_query->GetFieldID(), term_query->MatchTerm(), doc_freq);
+  return status.OK() ? doc_freq : UINT64_MAX;
+}
+
+}  // namespace wwsearch
@@ -0,0 +1,57 @@
+/*
+ * Tencent is pleased to support the open source community by making wwsearch
+ * available.
+ *
+ * Copyright (C) 2018-present Tencent. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * https://opensource.org/licenses/Apache-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OF ANY KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+#include "search_deadline.h"
+#include "stat_collector.h"
+
+namespace wwsearch {
+
+static uint64_t MonotonicMicros() { return Time::NowNanos() / 1000; }
+
+SearchDeadline::SearchDeadline(uint64_t timeout_us)
+    : deadline_us_(0), cancelled_(false) {
+  if (timeout_us > 0) {
+    deadline_us_ = MonotonicMicros() + timeout_us;
+  }
+}
+
+void SearchDeadline::Cancel() {
+  cancelled_.store(true, std::memory_order_relaxed);
+}
+
+bool SearchDeadline::Cancelled() const {
+  return cancelled_.load(std::memory_order_relaxed);
+}
+
+bool SearchDeadline::Expired() const {
+  return deadline_us_ > 0 && MonotonicMicros() >= deadline_us_;
+}
+
+bool SearchDeadline::Check(SearchStatus &status) const {
+  if (Cancelled()) {
+    status.SetStatus(kQueryCancelledStatus, "query cancelled");
+    return false;
+  }
+  if (Expired()) {
+    status.SetStatus(kQueryTimeoutStatus, "query timeout");
+    return false;
+  }
+  return true;
+}
+
+}  // namespace wwsearch
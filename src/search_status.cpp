@@ -48,6 +48,15 @@ bool SearchStatus::ReachMaxDocListSizeLimit() {
   return this->status_code_ == kReachMaxDocListSizeLimit;
 }
 
+bool SearchStatus::ReachMaxExpansionTermsLimit() {
+  return this->status_code_ == kReachMaxExpansionTermsLimit;
+}
+
+bool SearchStatus::Interrupted() {
+  return this->status_code_ == kQueryTimeoutStatus ||
+         this->status_code_ == kQueryCancelledStatus;
+}
+
 bool SearchStatus::OK() { return this->status_code_ == 0; }
 
 int SearchStatus::GetCode() const { return this->status_code_; }
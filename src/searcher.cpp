@@ -17,7 +17,23 @@
  */
 
 #include "searcher.h"
+#include <algorithm>
+#include <cmath>
+#include <condition_variable>
+#include <mutex>
+#include "and_not_query.h"
+#include "and_query.h"
+#include "batch_read_cache.h"
+#include "bool_query.h"
+#include "bool_scorer.h"
+#include "bool_weight.h"
 #include "collector_top.h"
+#include "completion_list.h"
+#include "filter_pushdown.h"
+#include "min_should_match_query.h"
+#include "query_result_cache.h"
+#include "or_query.h"
+#include "query_rewriter.h"
 
 namespace wwsearch {
 
@@ -27,15 +43,48 @@ SearchStatus Searcher::DoQuery(
     std::list<DocumentID> &docs,
     std::vector<std::shared_ptr<ScoreStrategy>> *score_strategy_list,
     size_t max_score_doc_num, uint32_t min_match_filter_num,
-    wwsearch::SearchTracer *tracer, uint32_t *get_match_total_cnt) {
+    wwsearch::SearchTracer *tracer, uint32_t *get_match_total_cnt,
+    HitEstimate *hit_estimate, SearchDeadline *deadline) {
   wwsearch::SearchTracer internal_tracer;
   if (tracer == nullptr) {
     tracer = &internal_tracer;
   }
   SearchStatus status;
+  // Table version must be read before snapshot,so result cached with it
+  // never contain less data than the version.
+  QueryResultCache *cache = config_->GetQueryResultCache();
+  std::string cache_key;
+  uint64_t table_version = config_->GetTableVersion()->Get(table);
+  uint32_t match_total_cnt_base =
+      (nullptr == get_match_total_cnt) ? 0 : *get_match_total_cnt;
+  // table is being written if no version,neither read nor fill cache.
+  bool use_cache =
+      nullptr != cache && TableVersion::kNoVersion != table_version &&
+      nullptr == hit_estimate &&
+      (nullptr == score_strategy_list || score_strategy_list->empty()) &&
+      BuildQueryCacheKey(query, offset, limit, filter, sorter,
+                         min_match_filter_num, nullptr != get_match_total_cnt,
+                         cache_key);
+  if (use_cache) {
+    if (cache->Get(table, cache_key, table_version, docs,
+                   get_match_total_cnt)) {
+      SearchLogDebug("DoQuery hit query result cache");
+      return status;
+    }
+  }
+
   VirtualDB *vdb = config_->VDB();
   VirtualDBSnapshot *snapshot = vdb->NewSnapshot();
   SearchContext context(table, vdb, snapshot, config_);
+  context.SetReadVersion(table_version);
+  context.SetDeadline(deadline);
+
+  // Filters on inverted indexed field are answered by index instead of
+  // docvalue.
+  FilterPushdown pushdown(config_);
+  Query *real_query = pushdown.Plan(&query, filter, min_match_filter_num);
+  QueryRewriter rewriter(&context);
+  real_query = rewriter.Rewrite(real_query);
 
   Weight *weight = nullptr;
   Scorer *scorer = nullptr;
@@ -44,7 +93,7 @@ SearchStatus Searcher::DoQuery(
     TimeCostCounter get_inverted_table_subquery_consume_us;
     get_inverted_table_subquery_consume_us.Start();
 
-    weight = query.CreateWeight(&context, false, 0);
+    weight = real_query->CreateWeight(&context, false, 0);
     scorer = weight->GetScorer(&context);
 
     tracer->Set(TracerType::kGetInvertedTableSubQueryConsumeUs,
@@ -61,27 +110,351 @@ SearchStatus Searcher::DoQuery(
   } else {
     SearchLogDebug("score_strategy_list ? %d, max_score_doc_num %d ",
                    score_strategy_list != nullptr, max_score_doc_num);
-    TopNCollector collector(table, offset, limit, this, &context, filter,
-                            sorter, score_strategy_list, max_score_doc_num,
-                            min_match_filter_num, tracer, get_match_total_cnt);
-    collector.SetScorer(scorer);
+    std::list<DocumentID> match_docs;
+    // Parallel only when docvalue must be read and serial collector could
+    // not stop early.
+    bool full_walk =
+        nullptr != get_match_total_cnt ||
+        (nullptr != sorter && !TopNCollector::MatchIndexSort(config_, sorter));
+    bool parallel =
+        nullptr != config_->GetQueryThreadPool() && nullptr == hit_estimate &&
+        config_->GetQueryParallelism() > 1 &&
+        (nullptr == score_strategy_list || score_strategy_list->empty()) &&
+        (nullptr != filter || nullptr != sorter) && full_walk;
+    if (parallel) {
+      status = ParallelCollect(&context, scorer, offset, limit, filter, sorter,
+                               min_match_filter_num, tracer,
+                               get_match_total_cnt, match_docs);
+    } else {
+      // Estimation need match count of purged documents.
+      uint32_t estimate_match_cnt = 0;
+      uint32_t *match_cnt = get_match_total_cnt;
+      if (nullptr != hit_estimate && nullptr == match_cnt) {
+        match_cnt = &estimate_match_cnt;
+      }
+      uint32_t match_cnt_base = (nullptr == match_cnt) ? 0 : *match_cnt;
+      TopNCollector collector(table, offset, limit, this, &context, filter,
+                              sorter, score_strategy_list, max_score_doc_num,
+                              min_match_filter_num, tracer, match_cnt);
+      collector.SetScorer(scorer);
+      collector.SetPrefetchPool(config_->GetQueryThreadPool());
+
+      uint64_t walked_docs = 0;
+      DocIdSetIterator &doc_lists = scorer->Iterator();
+      while (doc_lists.DocID() != DocIdSetIterator::NO_MORE_DOCS &&
+             !collector.Enough() && !context.Interrupted()) {
+        SearchLogDebug("DoQuery Colloct DocID=%llu", doc_lists.DocID());
+        collector.Collect(doc_lists.DocID(), doc_lists.FieldId());
+        doc_lists.NextDoc();
+        ++walked_docs;
+      }
+      collector.Finish();
+      status = collector.Status();
+      if (status.OK()) {
+        collector.GetAndClearMatchDocs(match_docs);
+        if (nullptr != hit_estimate) {
+          EstimateHits(walked_docs, collector.PurgedDocsCount(),
+                       *match_cnt - match_cnt_base, hit_estimate);
+        }
+      }
+    }
+    if (status.OK()) {
+      if (!context.Status().OK()) {
+        status = context.Status();
+      } else if (use_cache) {
+        cache->Put(table, cache_key, table_version, match_docs,
+                   (nullptr == get_match_total_cnt)
+                       ? 0
+                       : *get_match_total_cnt - match_total_cnt_base);
+      }
+      docs.splice(docs.begin(), match_docs);
+    }
+  }
+  delete weight;
+  delete scorer;
+  vdb->ReleaseSnapshot(snapshot);
+  return status;
+}
+
+SearchStatus Searcher::DoQueryAsync(const TableID &table, Query &query,
+                                    size_t offset, size_t limit,
+                                    std::vector<Filter *> *filter,
+                                    std::vector<SortCondition *> *sorter,
+                                    SearchCallback callback,
+                                    uint32_t min_match_filter_num,
+                                    SearchDeadline *deadline) {
+  SearchStatus status;
+  ThreadPool *executor = config_->GetSearchExecutor();
+  if (nullptr == executor) {
+    status.SetStatus(kScorerErrorStatus, "search executor not set");
+    return status;
+  }
+  AsyncQuery *async_query =
+      new AsyncQuery(this, config_, executor, table, query, offset, limit,
+                     filter, sorter, min_match_filter_num, deadline, callback);
+  async_query->Start();
+  return status;
+}
+
+SearchStatus Searcher::DoQueryAfter(const TableID &table, Query &query,
+                                    size_t limit,
+                                    std::vector<Filter *> *filter,
+                                    std::vector<SortCondition *> *sorter,
+                                    std::string &cursor,
+                                    std::list<DocumentID> &docs,
+                                    uint32_t min_match_filter_num,
+                                    wwsearch::SearchTracer *tracer) {
+  wwsearch::SearchTracer internal_tracer;
+  if (tracer == nullptr) {
+    tracer = &internal_tracer;
+  }
+  SearchStatus status;
+  Document search_after;
+  if (!cursor.empty() && !DecodeCursor(cursor, sorter, search_after)) {
+    status.SetStatus(kDataErrorStatus, "invalid cursor");
+    return status;
+  }
+  // id 1 is the last one in doc id order.
+  if (!cursor.empty() &&
+      (nullptr == sorter || TopNCollector::MatchIndexSort(config_, sorter)) &&
+      search_after.ID() <= 1) {
+    cursor.clear();
+    return status;
+  }
+
+  VirtualDB *vdb = config_->VDB();
+  uint64_t read_version = config_->GetTableVersion()->Get(table);
+  VirtualDBSnapshot *snapshot = vdb->NewSnapshot();
+  SearchContext context(table, vdb, snapshot, config_);
+  context.SetReadVersion(read_version);
+  FilterPushdown pushdown(config_);
+  Query *real_query = pushdown.Plan(&query, filter, min_match_filter_num);
+  QueryRewriter rewriter(&context);
+  real_query = rewriter.Rewrite(real_query);
+
+  std::vector<Document *> top_docs;
+  status = CollectTopDocs(&context, real_query, limit, filter, sorter,
+                          min_match_filter_num, tracer, nullptr, top_docs,
+                          cursor.empty() ? nullptr : &search_after);
+  if (status.OK()) {
+    for (auto document : top_docs) {
+      docs.push_back(document->ID());
+    }
+    cursor.clear();
+    if (!top_docs.empty() && top_docs.size() >= limit &&
+        !EncodeCursor(top_docs.back(), sorter, cursor)) {
+      status.SetStatus(kSerializeErrorStatus, "encode cursor error");
+    }
+  }
+  for (auto document : top_docs) {
+    delete document;
+  }
+  vdb->ReleaseSnapshot(snapshot);
+  return status;
+}
 
+SearchStatus Searcher::DoAggregation(const TableID &table, Query &query,
+                                     std::vector<Filter *> *filter,
+                                     std::vector<Aggregation *> &aggregations,
+                                     uint32_t min_match_filter_num,
+                                     wwsearch::SearchTracer *tracer) {
+  wwsearch::SearchTracer internal_tracer;
+  if (tracer == nullptr) {
+    tracer = &internal_tracer;
+  }
+  SearchStatus status;
+  VirtualDB *vdb = config_->VDB();
+  uint64_t read_version = config_->GetTableVersion()->Get(table);
+  VirtualDBSnapshot *snapshot = vdb->NewSnapshot();
+  SearchContext context(table, vdb, snapshot, config_);
+  context.SetReadVersion(read_version);
+  FilterPushdown pushdown(config_);
+  Query *real_query = pushdown.Plan(&query, filter, min_match_filter_num);
+  QueryRewriter rewriter(&context);
+  real_query = rewriter.Rewrite(real_query);
+
+  Weight *weight = real_query->CreateWeight(&context, false, 0);
+  Scorer *scorer = weight->GetScorer(&context);
+  if (nullptr == scorer) {
+    status = context.Status();
+    if (status.OK()) {
+      status.SetStatus(kScorerErrorStatus, "can not get scorer");
+    }
+  } else {
+    // No top n,documents are released once aggregated.
+    TopNCollector collector(table, 0, 0, this, &context, filter, nullptr,
+                            nullptr, SIZE_MAX, min_match_filter_num, tracer,
+                            nullptr);
+    collector.SetScorer(scorer);
+    collector.SetAggregations(&aggregations);
     DocIdSetIterator &doc_lists = scorer->Iterator();
     while (doc_lists.DocID() != DocIdSetIterator::NO_MORE_DOCS &&
            !collector.Enough()) {
-      SearchLogDebug("DoQuery Colloct DocID=%llu", doc_lists.DocID());
       collector.Collect(doc_lists.DocID(), doc_lists.FieldId());
       doc_lists.NextDoc();
     }
     collector.Finish();
-    if (!collector.Status().OK()) {
-      status = collector.Status();
+    status = collector.Status();
+    if (status.OK() && !context.Status().OK()) {
+      status = context.Status();
+    }
+  }
+  delete weight;
+  delete scorer;
+  vdb->ReleaseSnapshot(snapshot);
+  return status;
+}
+
+SearchStatus Searcher::DoFacet(const TableID &table, Query &query,
+                               std::vector<BooleanQuery *> &facets,
+                               std::vector<uint64_t> &counts,
+                               wwsearch::SearchTracer *tracer,
+                               SearchDeadline *deadline) {
+  wwsearch::SearchTracer internal_tracer;
+  if (tracer == nullptr) {
+    tracer = &internal_tracer;
+  }
+  counts.assign(facets.size(), 0);
+  SearchStatus status;
+  VirtualDB *vdb = config_->VDB();
+  uint64_t read_version = config_->GetTableVersion()->Get(table);
+  VirtualDBSnapshot *snapshot = vdb->NewSnapshot();
+  SearchContext context(table, vdb, snapshot, config_);
+  context.SetReadVersion(read_version);
+  context.SetDeadline(deadline);
+  QueryRewriter rewriter(&context);
+  Query *real_query = rewriter.Rewrite(&query);
+
+  TimeCostCounter get_inverted_table_subquery_consume_us;
+  get_inverted_table_subquery_consume_us.Start();
+  // Match doc ids in descending order.
+  std::vector<DocumentID> match_docs;
+  {
+    Weight *weight = real_query->CreateWeight(&context, false, 0);
+    Scorer *scorer = weight->GetScorer(&context);
+    if (nullptr == scorer) {
+      status = context.Status();
+      if (status.OK()) {
+        status.SetStatus(kScorerErrorStatus, "can not get scorer");
+      }
     } else {
-      collector.GetAndClearMatchDocs(docs);
-      if (!context.Status().OK()) {
-        status = context.Status();
+      DocIdSetIterator &doc_lists = scorer->Iterator();
+      for (; doc_lists.DocID() != DocIdSetIterator::NO_MORE_DOCS &&
+             !context.Interrupted();
+           doc_lists.NextDoc()) {
+        match_docs.push_back(doc_lists.DocID());
       }
     }
+    delete weight;
+    delete scorer;
+  }
+
+  for (size_t i = 0; status.OK() && i < facets.size(); i++) {
+    if (match_docs.empty() || context.Interrupted()) break;
+    Weight *weight = facets[i]->CreateWeight(&context, false, 0);
+    Scorer *scorer = weight->GetScorer(&context);
+    if (nullptr == scorer) {
+      status = context.Status();
+      if (status.OK()) {
+        status.SetStatus(kScorerErrorStatus, "can not get scorer");
+      }
+    } else {
+      DocIdSetIterator &term_docs = scorer->Iterator();
+      uint64_t count = 0;
+      // Few match documents,binary search each in term doc list.
+      if (match_docs.size() * 16 < term_docs.Cost()) {
+        for (auto doc : match_docs) {
+          if (context.Interrupted()) break;
+          if (term_docs.Advance(doc) == doc) count++;
+        }
+      } else {
+        DocumentID term_doc = term_docs.DocID();
+        size_t j = 0;
+        while (j < match_docs.size() &&
+               term_doc != DocIdSetIterator::NO_MORE_DOCS &&
+               !context.Interrupted()) {
+          if (match_docs[j] == term_doc) {
+            count++;
+            j++;
+            term_doc = term_docs.NextDoc();
+          } else if (match_docs[j] > term_doc) {
+            j++;
+          } else {
+            term_doc = term_docs.NextDoc();
+          }
+        }
+      }
+      counts[i] = count;
+    }
+    delete weight;
+    delete scorer;
+  }
+  tracer->Set(TracerType::kGetInvertedTableSubQueryConsumeUs,
+              get_inverted_table_subquery_consume_us.CostUs());
+  // partial counts are returned with timeout.
+  if (status.OK() && !context.Status().OK()) {
+    status = context.Status();
+  }
+  vdb->ReleaseSnapshot(snapshot);
+  return status;
+}
+
+SearchStatus Searcher::DoCount(const TableID &table, Query &query,
+                               std::vector<Filter *> *filter, uint64_t &count,
+                               uint32_t min_match_filter_num,
+                               wwsearch::SearchTracer *tracer) {
+  wwsearch::SearchTracer internal_tracer;
+  if (tracer == nullptr) {
+    tracer = &internal_tracer;
+  }
+  count = 0;
+  SearchStatus status;
+  VirtualDB *vdb = config_->VDB();
+  uint64_t read_version = config_->GetTableVersion()->Get(table);
+  VirtualDBSnapshot *snapshot = vdb->NewSnapshot();
+  SearchContext context(table, vdb, snapshot, config_);
+  context.SetReadVersion(read_version);
+
+  std::vector<Filter *> *real_filter = filter;
+  FilterPushdown pushdown(config_);
+  Query *real_query = pushdown.Plan(&query, real_filter, min_match_filter_num);
+  if (nullptr != real_filter && !real_filter->empty()) {
+    vdb->ReleaseSnapshot(snapshot);
+    SearchLogDebug("DoCount fall back to collector,filter left:%u",
+                   real_filter->size());
+    std::list<DocumentID> docs;
+    uint32_t match_total_cnt = 0;
+    status = DoQuery(table, query, 0, 0, filter, nullptr, docs, nullptr,
+                     SIZE_MAX, min_match_filter_num, tracer, &match_total_cnt);
+    count = match_total_cnt;
+    return status;
+  }
+  QueryRewriter rewriter(&context);
+  real_query = rewriter.Rewrite(real_query);
+
+  TimeCostCounter get_inverted_table_subquery_consume_us;
+  get_inverted_table_subquery_consume_us.Start();
+  Weight *weight = real_query->CreateWeight(&context, false, 0);
+  Scorer *scorer = weight->GetScorer(&context);
+  tracer->Set(TracerType::kGetInvertedTableSubQueryConsumeUs,
+              get_inverted_table_subquery_consume_us.CostUs());
+  if (nullptr == scorer) {
+    status = context.Status();
+    if (status.OK()) {
+      status.SetStatus(kScorerErrorStatus, "can not get scorer");
+    }
+  } else if (nullptr != dynamic_cast<BooleanScorer *>(scorer)) {
+    // single doc list,its length is what iterating it would count.
+    count = scorer->Iterator().Cost();
+  } else {
+    DocIdSetIterator &doc_lists = scorer->Iterator();
+    while (doc_lists.DocID() != DocIdSetIterator::NO_MORE_DOCS) {
+      ++count;
+      doc_lists.NextDoc();
+    }
+  }
+  if (status.OK() && !context.Status().OK()) {
+    status = context.Status();
   }
   delete weight;
   delete scorer;
@@ -89,6 +462,504 @@ SearchStatus Searcher::DoQuery(
   return status;
 }
 
+SearchStatus Searcher::DoQuery(
+    const std::vector<TableID> &tables, Query &query, size_t offset,
+    size_t limit, std::vector<Filter *> *filter,
+    std::vector<SortCondition *> *sorter,
+    std::list<std::pair<TableID, DocumentID>> &docs,
+    uint32_t min_match_filter_num, wwsearch::SearchTracer *tracer,
+    uint32_t *get_match_total_cnt) {
+  wwsearch::SearchTracer internal_tracer;
+  if (tracer == nullptr) {
+    tracer = &internal_tracer;
+  }
+  VirtualDB *vdb = config_->VDB();
+  std::vector<uint64_t> read_versions;
+  for (const auto &table : tables) {
+    read_versions.push_back(config_->GetTableVersion()->Get(table));
+  }
+  VirtualDBSnapshot *snapshot = vdb->NewSnapshot();
+
+  struct TableResult {
+    SearchStatus status;
+    SearchStatus context_status;
+    SearchTracer tracer;
+    uint32_t match_total_cnt{0};
+    std::vector<Document *> top_docs;
+  };
+  std::vector<TableResult> results(tables.size());
+  auto run = [&](size_t i) {
+    TableResult &result = results[i];
+    SearchContext context(tables[i], vdb, snapshot, config_);
+    context.SetReadVersion(read_versions[i]);
+    uint32_t *match_total_cnt =
+        (nullptr == get_match_total_cnt) ? nullptr : &result.match_total_cnt;
+    std::vector<Filter *> *table_filter = filter;
+    FilterPushdown pushdown(config_);
+    Query *real_query =
+        pushdown.Plan(&query, table_filter, min_match_filter_num);
+    QueryRewriter rewriter(&context);
+    real_query = rewriter.Rewrite(real_query);
+    result.status = CollectTopDocs(&context, real_query, offset + limit,
+                                   table_filter, sorter, min_match_filter_num,
+                                   &result.tracer, match_total_cnt,
+                                   result.top_docs);
+  };
+
+  RunParts(config_->GetQueryThreadPool(), tables.size(), run);
+  vdb->ReleaseSnapshot(snapshot);
+
+  SearchStatus status;
+  for (auto &result : results) {
+    tracer->Merge(result.tracer);
+    if (nullptr != get_match_total_cnt) {
+      (*get_match_total_cnt) += result.match_total_cnt;
+    }
+    if (status.OK() && !result.status.OK()) {
+      status = result.status;
+    }
+  }
+
+  // K-way merge of per table lists which are already ordered,stop once
+  // offset + limit documents are popped.Ties go to the former table.
+  if (status.OK()) {
+    Sorter better(sorter);
+    typedef std::pair<size_t, size_t> Cursor;  // table index,doc index
+    auto worse = [&](const Cursor &lhs, const Cursor &rhs) {
+      Document *l = results[lhs.first].top_docs[lhs.second];
+      Document *r = results[rhs.first].top_docs[rhs.second];
+      if (better(r, l)) return true;
+      if (better(l, r)) return false;
+      return lhs.first > rhs.first;
+    };
+    std::priority_queue<Cursor, std::vector<Cursor>, decltype(worse)> heads(
+        worse);
+    for (size_t i = 0; i < results.size(); i++) {
+      if (!results[i].top_docs.empty()) heads.push(Cursor(i, 0));
+    }
+    size_t skip = offset;
+    size_t left = limit;
+    std::list<std::pair<TableID, DocumentID>> match_docs;
+    while (!heads.empty() && left > 0) {
+      Cursor head = heads.top();
+      heads.pop();
+      if (skip > 0) {
+        --skip;
+      } else {
+        Document *document = results[head.first].top_docs[head.second];
+        match_docs.emplace_back(tables[head.first], document->ID());
+        --left;
+      }
+      if (++head.second < results[head.first].top_docs.size()) {
+        heads.push(head);
+      }
+    }
+    docs.splice(docs.end(), match_docs);
+  }
+
+  for (auto &result : results) {
+    for (auto document : result.top_docs) {
+      delete document;
+    }
+  }
+  return status;
+}
+
+// Inverted keys of all term queries in query tree.
+static void CollectTermKeys(SearchContext *context, Query *query,
+                            std::set<std::string> &keys) {
+  const std::vector<Query *> *sub_query = nullptr;
+  if (nullptr != dynamic_cast<AndQuery *>(query)) {
+    sub_query = &dynamic_cast<AndQuery *>(query)->SubQuery();
+  } else if (nullptr != dynamic_cast<OrQuery *>(query)) {
+    sub_query = &dynamic_cast<OrQuery *>(query)->SubQuery();
+  } else if (nullptr != dynamic_cast<MinShouldMatchQuery *>(query)) {
+    sub_query = &dynamic_cast<MinShouldMatchQuery *>(query)->SubQuery();
+  } else if (nullptr != dynamic_cast<AndNotQuery *>(query)) {
+    AndNotQuery *and_not_query = dynamic_cast<AndNotQuery *>(query);
+    for (auto sub : and_not_query->ExcludedQuery()) {
+      CollectTermKeys(context, sub, keys);
+    }
+    sub_query = &and_not_query->RequiredQuery();
+  } else if (nullptr != dynamic_cast<BooleanQuery *>(query)) {
+    std::string key;
+    if (BooleanWeight::EncodeInvertedKey(
+            context, dynamic_cast<BooleanQuery *>(query), key)) {
+      keys.insert(key);
+    }
+  }
+  if (nullptr != sub_query) {
+    for (auto sub : *sub_query) {
+      CollectTermKeys(context, sub, keys);
+    }
+  }
+}
+
+SearchStatus Searcher::DoQueries(const TableID &table,
+                                 std::vector<SearchRequest> &requests,
+                                 wwsearch::SearchTracer *tracer) {
+  wwsearch::SearchTracer internal_tracer;
+  if (tracer == nullptr) {
+    tracer = &internal_tracer;
+  }
+  SearchStatus status;
+  VirtualDB *vdb = config_->VDB();
+  uint64_t read_version = config_->GetTableVersion()->Get(table);
+  VirtualDBSnapshot *snapshot = vdb->NewSnapshot();
+  BatchReadCache batch_read_cache(config_->GetMaxBatchReadCacheBytes());
+
+  // Plan all queries first,so doc lists shared by them are known.
+  struct Plan {
+    std::unique_ptr<SearchContext> context;
+    std::unique_ptr<FilterPushdown> pushdown;
+    std::unique_ptr<QueryRewriter> rewriter;
+    std::vector<Filter *> *filter;
+    Query *query;
+  };
+  std::vector<Plan> plans(requests.size());
+  // number of queries reading each doc list.
+  std::map<std::string, uint32_t> term_queries;
+  for (size_t i = 0; i < requests.size(); i++) {
+    Plan &plan = plans[i];
+    SearchRequest &request = requests[i];
+    plan.context.reset(new SearchContext(table, vdb, snapshot, config_));
+    plan.context->SetReadVersion(read_version);
+    plan.context->SetBatchReadCache(&batch_read_cache);
+    plan.pushdown.reset(new FilterPushdown(config_));
+    plan.rewriter.reset(new QueryRewriter(plan.context.get()));
+    plan.filter = request.filter;
+    plan.query = plan.pushdown->Plan(request.query, plan.filter,
+                                     request.min_match_filter_num);
+    plan.query = plan.rewriter->Rewrite(plan.query);
+    std::set<std::string> term_keys;
+    CollectTermKeys(plan.context.get(), plan.query, term_keys);
+    for (const auto &key : term_keys) {
+      term_queries[key]++;
+    }
+  }
+
+  {
+    TimeCostCounter get_inverted_table_subquery_consume_us;
+    get_inverted_table_subquery_consume_us.Start();
+    // doc list of one query only is read by its weight,not kept.
+    std::vector<std::string> keys;
+    for (const auto &item : term_queries) {
+      if (item.second > 1) keys.push_back(item.first);
+    }
+    std::vector<StorageColumnType> columns(keys.size(), kInvertedIndexColumn);
+    std::vector<std::string> values;
+    std::vector<SearchStatus> values_status;
+    vdb->MultiGet(columns, keys, values, values_status, snapshot);
+    assert(values_status.size() == keys.size());
+    for (size_t i = 0; i < keys.size(); i++) {
+      batch_read_cache.Put(kInvertedIndexColumn, keys[i], values_status[i],
+                           values[i]);
+    }
+    tracer->Add(TracerType::kGetInvertedTableSubQueryCount, keys.size());
+    tracer->Add(TracerType::kGetInvertedTableSubQueryConsumeUs,
+                get_inverted_table_subquery_consume_us.CostUs());
+  }
+
+  for (size_t i = 0; i < requests.size(); i++) {
+    Plan &plan = plans[i];
+    SearchRequest &request = requests[i];
+    std::vector<Document *> top_docs;
+    request.match_total_cnt = 0;
+    request.status = CollectTopDocs(
+        plan.context.get(), plan.query, request.offset + request.limit,
+        plan.filter, request.sorter, request.min_match_filter_num, tracer,
+        request.need_match_total_cnt ? &request.match_total_cnt : nullptr,
+        top_docs);
+    for (size_t j = 0; j < top_docs.size(); j++) {
+      if (request.status.OK() && j >= request.offset) {
+        request.docs.push_back(top_docs[j]->ID());
+      }
+      delete top_docs[j];
+    }
+  }
+  vdb->ReleaseSnapshot(snapshot);
+  return status;
+}
+
+SearchStatus Searcher::CollectTopDocs(SearchContext *context, Query *query,
+                                      size_t top_n,
+                                      std::vector<Filter *> *filter,
+                                      std::vector<SortCondition *> *sorter,
+                                      uint32_t min_match_filter_num,
+                                      wwsearch::SearchTracer *tracer,
+                                      uint32_t *get_match_total_cnt,
+                                      std::vector<Document *> &top_docs,
+                                      Document *search_after) {
+  SearchStatus status;
+  Weight *weight = query->CreateWeight(context, false, 0);
+  Scorer *scorer = weight->GetScorer(context);
+  if (nullptr == scorer) {
+    status = context->Status();
+    if (status.OK()) {
+      status.SetStatus(kScorerErrorStatus, "can not get scorer");
+    }
+  } else {
+    TopNCollector collector(context->Table(), 0, top_n, this, context, filter,
+                            sorter, nullptr, SIZE_MAX, min_match_filter_num,
+                            tracer, get_match_total_cnt);
+    collector.SetScorer(scorer);
+    DocIdSetIterator &doc_lists = scorer->Iterator();
+    if (nullptr != search_after) {
+      if (nullptr == sorter || TopNCollector::MatchIndexSort(config_, sorter)) {
+        // doc id order,skip to the one after last.
+        doc_lists.Advance(search_after->ID() - 1);
+      } else {
+        collector.SetSearchAfter(search_after);
+      }
+    }
+    while (doc_lists.DocID() != DocIdSetIterator::NO_MORE_DOCS &&
+           !collector.Enough() && !context->Interrupted()) {
+      collector.Collect(doc_lists.DocID(), doc_lists.FieldId());
+      doc_lists.NextDoc();
+    }
+    collector.Finish();
+    status = collector.Status();
+    if (status.OK() && !context->Status().OK()) {
+      status = context->Status();
+    }
+    if (status.OK()) {
+      // heap pops worst first
+      collector.GetAndClearTopDocs(top_docs);
+      std::reverse(top_docs.begin(), top_docs.end());
+    }
+  }
+  delete weight;
+  delete scorer;
+  return status;
+}
+
+// Doc list is walked once in memory and split into disjoint doc id ranges,
+// docvalue read & filter of each range run on query thread pool.Top docs of
+// ranges are pushed into one heap in doc id order like serial collector.
+SearchStatus Searcher::ParallelCollect(
+    SearchContext *context, Scorer *scorer, size_t offset, size_t limit,
+    std::vector<Filter *> *filter, std::vector<SortCondition *> *sorter,
+    uint32_t min_match_filter_num, wwsearch::SearchTracer *tracer,
+    uint32_t *get_match_total_cnt, std::list<DocumentID> &docs) {
+  std::vector<std::pair<DocumentID, int>> candidates;
+  size_t max_candidates = config_->GetMaxInnerPurgeDocsTotalLimit() + 1;
+  DocIdSetIterator &doc_lists = scorer->Iterator();
+  while (doc_lists.DocID() != DocIdSetIterator::NO_MORE_DOCS &&
+         !context->Interrupted()) {
+    if (candidates.size() >= max_candidates) {
+      tracer->Add(TracerType::kExceedInnerPurgeDocsTotalLimitCount, 1);
+      break;
+    }
+    candidates.emplace_back(doc_lists.DocID(), doc_lists.FieldId());
+    doc_lists.NextDoc();
+  }
+
+  size_t min_partition_docs =
+      std::max<size_t>(1, config_->GetMinParallelPartitionDocs());
+  size_t partition_num = std::min<size_t>(
+      config_->GetQueryParallelism(), candidates.size() / min_partition_docs);
+  if (partition_num == 0) partition_num = 1;
+
+  struct Partition {
+    SearchStatus status;
+    SearchStatus context_status;
+    SearchTracer tracer;
+    uint32_t match_total_cnt{0};
+    std::vector<Document *> top_docs;
+  };
+  std::vector<Partition> partitions(partition_num);
+  auto run = [&](size_t i) {
+    Partition &partition = partitions[i];
+    SearchContext partition_context(context->Table(), context->VDB(),
+                                    context->GetSnapshot(), config_);
+    partition_context.SetReadVersion(context->ReadVersion());
+    partition_context.SetDeadline(context->GetDeadline());
+    uint32_t *match_total_cnt = (nullptr == get_match_total_cnt)
+                                    ? nullptr
+                                    : &partition.match_total_cnt;
+    TopNCollector collector(context->Table(), 0, offset + limit, this,
+                            &partition_context, filter, sorter, nullptr,
+                            SIZE_MAX, min_match_filter_num, &partition.tracer,
+                            match_total_cnt);
+    size_t end = candidates.size() * (i + 1) / partition_num;
+    for (size_t j = candidates.size() * i / partition_num; j < end; j++) {
+      collector.Collect(candidates[j].first, candidates[j].second);
+    }
+    collector.Finish();
+    partition.status = collector.Status();
+    partition.context_status = partition_context.Status();
+    collector.GetAndClearTopDocs(partition.top_docs);
+  };
+
+  RunParts(config_->GetQueryThreadPool(), partition_num, run);
+
+  SearchStatus status;
+  std::vector<Document *> top_docs;
+  for (auto &partition : partitions) {
+    tracer->Merge(partition.tracer);
+    if (nullptr != get_match_total_cnt) {
+      (*get_match_total_cnt) += partition.match_total_cnt;
+    }
+    if (status.OK() && !partition.status.OK()) {
+      status = partition.status;
+    }
+    // Timeout of range is reported by caller's context with partial docs.
+    if (context->Status().OK() && !partition.context_status.OK()) {
+      context->Status() = partition.context_status;
+    }
+    top_docs.insert(top_docs.end(), partition.top_docs.begin(),
+                    partition.top_docs.end());
+  }
+  if (!status.OK()) {
+    for (auto document : top_docs) {
+      delete document;
+    }
+    return status;
+  }
+
+  std::sort(top_docs.begin(), top_docs.end(),
+            [](Document *lhs, Document *rhs) { return lhs->ID() > rhs->ID(); });
+  TopNCollector merger(context->Table(), offset, limit, this, context, nullptr,
+                       sorter, nullptr, SIZE_MAX, 0, tracer, nullptr);
+  merger.MergeTopDocs(top_docs);
+  merger.GetAndClearMatchDocs(docs);
+  return status;
+}
+
+// Parts are claimed by flag,a task claiming nothing returns without
+// touching caller's frame,so caller never waits on a queued task.
+void Searcher::RunParts(ThreadPool *pool, size_t num,
+                        const std::function<void(size_t)> &run) {
+  struct Progress {
+    std::mutex mutex;
+    std::condition_variable cv;
+    std::vector<bool> started;
+    size_t done{0};
+
+    bool Claim(size_t i) {
+      std::lock_guard<std::mutex> lock(mutex);
+      if (started[i]) return false;
+      started[i] = true;
+      return true;
+    }
+
+    void Finish() {
+      std::lock_guard<std::mutex> lock(mutex);
+      done++;
+      cv.notify_all();
+    }
+  };
+  auto progress = std::make_shared<Progress>();
+  progress->started.assign(num, false);
+  for (size_t i = 1; nullptr != pool && i < num; i++) {
+    pool->Submit([progress, &run, i] {
+      if (!progress->Claim(i)) return;
+      run(i);
+      progress->Finish();
+    });
+  }
+  for (size_t i = 0; i < num; i++) {
+    if (!progress->Claim(i)) continue;
+    run(i);
+    progress->Finish();
+  }
+  std::unique_lock<std::mutex> lock(progress->mutex);
+  progress->cv.wait(lock, [&] { return progress->done == num; });
+}
+
+// Cursor format : version | sorted | document with docvalue of sort fields.
+bool Searcher::EncodeCursor(Document *document,
+                            std::vector<SortCondition *> *sorter,
+                            std::string &cursor) {
+  lsmsearch::StoreDocument last;
+  last.set_document_id(document->ID());
+  std::set<FieldID> field_ids;
+  for (size_t i = 0; nullptr != sorter && i < sorter->size(); i++) {
+    IndexField *field = document->FindField((*sorter)[i]->GetID());
+    if (nullptr == field || !field_ids.insert(field->ID()).second) continue;
+    if (!field->EncodeToStoreField(last.add_fields(), 1)) return false;
+  }
+  std::string buffer;
+  if (!last.SerializeToString(&buffer)) return false;
+  AppendFixed8(cursor, 1);
+  AppendFixed8(cursor, nullptr != sorter);
+  cursor.append(buffer);
+  return true;
+}
+
+bool Searcher::DecodeCursor(const std::string &cursor,
+                            std::vector<SortCondition *> *sorter,
+                            Document &document) {
+  if (cursor.size() < 2 || 1 != cursor[0]) return false;
+  if ((0 != cursor[1]) != (nullptr != sorter)) return false;
+  return document.DeSerializeFromByte(cursor.c_str() + 2, cursor.size() - 2);
+}
+
+// Filter pass rate of purged documents is a sample of all candidates.
+// Error bound is normal approximation of binomial at 95% confidence,pass
+// rate is smoothed so that it is not zero when no or all sampled documents
+// pass.
+void Searcher::EstimateHits(uint64_t candidate_docs, uint64_t purged_docs,
+                            uint64_t match_docs, HitEstimate *hit_estimate) {
+  assert(purged_docs <= candidate_docs);
+  uint64_t rest_docs = candidate_docs - purged_docs;
+  if (0 == rest_docs || 0 == purged_docs) {
+    hit_estimate->exact = (0 == rest_docs);
+    hit_estimate->total = match_docs + rest_docs;
+    hit_estimate->error_bound = rest_docs;
+    return;
+  }
+  double pass_rate = static_cast<double>(match_docs) / purged_docs;
+  double smooth_rate = (match_docs + 1.0) / (purged_docs + 2.0);
+  double stddev = std::sqrt(smooth_rate * (1 - smooth_rate) / purged_docs);
+  hit_estimate->exact = false;
+  hit_estimate->total = match_docs + std::llround(pass_rate * rest_docs);
+  hit_estimate->error_bound =
+      std::min<uint64_t>(rest_docs, std::ceil(1.96 * stddev * rest_docs));
+}
+
+// Canonical key of one DoQuery request.
+bool Searcher::BuildQueryCacheKey(Query &query, size_t offset, size_t limit,
+                                  std::vector<Filter *> *filter,
+                                  std::vector<SortCondition *> *sorter,
+                                  uint32_t min_match_filter_num,
+                                  bool need_match_total_cnt,
+                                  std::string &key) {
+  AppendFixed64(key, offset);
+  AppendFixed64(key, limit);
+  AppendFixed32(key, min_match_filter_num);
+  AppendFixed8(key, need_match_total_cnt);
+
+  std::string sub_key;
+  if (!QueryRewriter::EncodeQueryKey(&query, sub_key)) return false;
+  AppendFixed32(key, sub_key.size());
+  key.append(sub_key);
+
+  // nullptr and empty filter differ,empty filter reads docvalue.
+  AppendFixed8(key, nullptr != filter);
+  if (nullptr != filter) {
+    AppendFixed32(key, filter->size());
+    for (auto rule : *filter) {
+      sub_key.clear();
+      if (!rule->EncodeKey(sub_key)) return false;
+      AppendFixed32(key, sub_key.size());
+      key.append(sub_key);
+    }
+  }
+
+  AppendFixed8(key, nullptr != sorter);
+  if (nullptr != sorter) {
+    AppendFixed32(key, sorter->size());
+    for (auto condition : *sorter) {
+      sub_key.clear();
+      if (!condition->EncodeKey(sub_key)) return false;
+      AppendFixed32(key, sub_key.size());
+      key.append(sub_key);
+    }
+  }
+  return true;
+}
+
 SearchStatus Searcher::GetStoredFields(const TableID &table,
                                        std::vector<Document *> &docs,
                                        std::vector<SearchStatus> &status,
@@ -103,6 +974,49 @@ SearchStatus Searcher::GetDocValue(const TableID &table,
   return InnerGetFields(1, table, docs, status, context);
 }
 
+SearchStatus Searcher::Complete(
+    const TableID &table, FieldID field_id, const std::string &prefix,
+    uint32_t top_k,
+    std::vector<std::pair<std::string, uint64_t>> &suggestions) {
+  SearchStatus status;
+  suggestions.clear();
+  uint32_t max_prefix_len = this->config_->GetMaxCompletionPrefixLen();
+  if (prefix.empty() || 0 == top_k || 0 == max_prefix_len) return status;
+
+  // cut prefix to indexed length,at utf-8 code point boundary.
+  size_t indexed_size = prefix.size();
+  uint32_t prefix_len = 0;
+  for (size_t i = 1; i <= prefix.size(); i++) {
+    if (i < prefix.size() && (prefix[i] & 0xC0) == 0x80) continue;
+    if (++prefix_len > max_prefix_len) break;
+    indexed_size = i;
+  }
+
+  std::string key;
+  std::string value;
+  this->config_->GetCodec()->EncodeCompletionKey(
+      table, field_id, prefix.substr(0, indexed_size), key);
+  status = this->config_->VDB()->Get(kMetaColumn, key, value, nullptr);
+  if (status.DocumentNotExist()) {
+    return SearchStatus();
+  }
+  if (!status.OK()) return status;
+
+  CompletionList list;
+  if (!list.Deserialize(value)) {
+    status.SetStatus(kSerializeErrorStatus, "completion list corrupt");
+    return status;
+  }
+  std::vector<CompletionList::Entry> entries;
+  list.TopK(list.Size(), entries);
+  for (const auto &entry : entries) {
+    if (suggestions.size() >= top_k) break;
+    if (0 != entry.first.compare(0, prefix.size(), prefix)) continue;
+    suggestions.emplace_back(entry.first, entry.second);
+  }
+  return status;
+}
+
 SearchStatus Searcher::InnerGetFields(int mode, const TableID &table,
                                       std::vector<Document *> &docs,
                                       std::vector<SearchStatus> &status,
@@ -110,34 +1024,63 @@ SearchStatus Searcher::InnerGetFields(int mode, const TableID &table,
   SearchStatus search_status;
   std::vector<StorageColumnType> columns;
   std::vector<std::string> keys;
-  std::vector<std::string> values;
+  // value of docs[i],points to values or batch_read_cache.
+  std::vector<const std::string *> values(docs.size(), nullptr);
+  StorageColumnType column = (0 == mode) ? kStoredFieldColumn : kDocValueColumn;
+  BatchReadCache *batch_read_cache =
+      (nullptr != context) ? context->GetBatchReadCache() : nullptr;
+  status.resize(docs.size());
 
-  // build keys
+  // build keys,documents read by former queries of batch are skipped.
+  std::vector<size_t> read_index;
   std::string document_key;
   for (size_t i = 0; i < docs.size(); i++) {
     this->config_->GetCodec()->EncodeStoredFieldKey(table, docs[i]->ID(),
                                                     document_key);
-    if (0 == mode)
-      columns.push_back(kStoredFieldColumn);
-    else
-      columns.push_back(kDocValueColumn);
+    const BatchReadCache::Entry *entry = nullptr;
+    if (nullptr != batch_read_cache) {
+      entry = batch_read_cache->Get(column, document_key);
+    }
+    if (nullptr != entry) {
+      status[i] = entry->status;
+      values[i] = &entry->value;
+      document_key.clear();
+      continue;
+    }
+    read_index.push_back(i);
+    columns.push_back(column);
     keys.push_back(std::move(document_key));
     assert(document_key.size() == 0);
   }
 
   // get from snapshot?
+  std::vector<std::string> read_values;
+  std::vector<SearchStatus> read_status;
   if (nullptr != context) {
-    context->VDB()->MultiGet(columns, keys, values, status,
+    context->VDB()->MultiGet(columns, keys, read_values, read_status,
                              context->GetSnapshot());
   } else {
-    this->config_->VDB()->MultiGet(columns, keys, values, status, nullptr);
+    this->config_->VDB()->MultiGet(columns, keys, read_values, read_status,
+                                   nullptr);
+  }
+  assert(read_status.size() == read_index.size());
+  for (size_t i = 0; i < read_index.size(); i++) {
+    const BatchReadCache::Entry *entry = nullptr;
+    if (nullptr != batch_read_cache) {
+      entry = batch_read_cache->Put(column, keys[i], read_status[i],
+                                    read_values[i]);
+    }
+    status[read_index[i]] = read_status[i];
+    values[read_index[i]] =
+        (nullptr != entry) ? &entry->value : &read_values[i];
   }
 
   // parse
   assert(status.size() == docs.size());
   for (size_t i = 0; i < docs.size(); i++) {
     if (status[i].OK()) {
-      if (!docs[i]->DeSerializeFromByte(values[i].c_str(), values[i].size())) {
+      if (!docs[i]->DeSerializeFromByte(values[i]->c_str(),
+                                        values[i]->size())) {
         status[i].SetStatus(kSerializeErrorStatus, "Deserizlize bytes error");
       }
     }
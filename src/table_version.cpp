@@ -0,0 +1,61 @@
+/*
+ * Tencent is pleased to support the open source community by making wwsearch
+ * available.
+ *
+ * Copyright (C) 2018-present Tencent. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * https://opensource.org/licenses/Apache-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OF ANY KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+#include "table_version.h"
+
+namespace wwsearch {
+
+const uint64_t TableVersion::kNoVersion;
+
+TableVersion::TableVersion(size_t slots) : slots_(slots == 0 ? 1 : slots) {
+  versions_.reset(new std::atomic<uint64_t>[slots_]);
+  writing_.reset(new std::atomic<uint32_t>[slots_]);
+  for (size_t i = 0; i < slots_; i++) {
+    versions_[i].store(0);
+    writing_[i].store(0);
+  }
+}
+
+size_t TableVersion::Slot(const TableID &table) {
+  uint64_t h = table.partition_set * 0x9E3779B97F4A7C15ULL;
+  h ^= (h >> 29) ^ table.business_type;
+  return h % slots_;
+}
+
+// Version is read before writing_.Zero writing_ means writes seen by
+// version have ended,or write begins after,then it bumps version again.
+uint64_t TableVersion::Get(const TableID &table) {
+  size_t slot = Slot(table);
+  uint64_t version = versions_[slot].load();
+  if (0 != writing_[slot].load()) return kNoVersion;
+  return version;
+}
+
+void TableVersion::BeginWrite(const TableID &table) {
+  size_t slot = Slot(table);
+  writing_[slot].fetch_add(1);
+  versions_[slot].fetch_add(1);
+}
+
+void TableVersion::EndWrite(const TableID &table) {
+  size_t slot = Slot(table);
+  versions_[slot].fetch_add(1);
+  writing_[slot].fetch_sub(1);
+}
+
+}  // namespace wwsearch
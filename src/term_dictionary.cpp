@@ -0,0 +1,138 @@
+/*
+ * Tencent is pleased to support the open source community by making wwsearch
+ * available.
+ *
+ * Copyright (C) 2018-present Tencent. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * https://opensource.org/licenses/Apache-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OF ANY KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+#include "term_dictionary.h"
+#include "coding.h"
+#include "search_context.h"
+#include "utils.h"
+
+namespace wwsearch {
+
+TermDictionary::TermDictionary(SearchContext *context, FieldID field)
+    : context_(context), iterator_(nullptr), doc_freq_(0) {
+  context->GetConfig()->GetCodec()->EncodeInvertedKey(context->Table(), field,
+                                                      "", field_key_);
+}
+
+TermDictionary::~TermDictionary() {
+  if (nullptr != iterator_) {
+    delete iterator_;
+    iterator_ = nullptr;
+  }
+}
+
+void TermDictionary::Seek(const std::string &term) {
+  if (nullptr == iterator_) {
+    VirtualDBReadOption options;
+    options.snapshot_ = context_->GetSnapshot();
+    options.iterate_upper_bound_ = PrefixSuccessor(field_key_);
+    iterator_ = context_->VDB()->NewIterator(kDictionaryColumn, &options);
+    if (nullptr == iterator_) return;
+  }
+  iterator_->Seek(field_key_ + term);
+  FindLive();
+}
+
+void TermDictionary::Next() {
+  assert(nullptr != iterator_);
+  iterator_->Next();
+  FindLive();
+}
+
+void TermDictionary::FindLive() {
+  for (; iterator_->Valid(); iterator_->Next()) {
+    Slice key = iterator_->key();
+    if (!HasPrefix(key.data(), key.size(), field_key_)) break;
+    int64_t doc_freq = DecodeDocFreq(iterator_->value());
+    if (doc_freq <= 0) continue;
+    term_.assign(key.data() + field_key_.size(),
+                 key.size() - field_key_.size());
+    doc_freq_ = doc_freq;
+    return;
+  }
+  delete iterator_;
+  iterator_ = nullptr;
+}
+
+SearchStatus TermDictionary::ReadDocLists(
+    const std::vector<std::string> &terms, std::vector<std::string> &values) {
+  SearchStatus status;
+  std::vector<StorageColumnType> columns(terms.size(), kInvertedIndexColumn);
+  std::vector<std::string> keys;
+  keys.reserve(terms.size());
+  for (const auto &term : terms) {
+    keys.push_back(field_key_ + term);
+  }
+  std::vector<SearchStatus> status_list;
+  values.clear();
+  context_->VDB()->MultiGet(columns, keys, values, status_list,
+                            context_->GetSnapshot());
+  for (size_t i = 0; i < status_list.size(); i++) {
+    if (status_list[i].DocumentNotExist()) {
+      values[i].clear();
+    } else if (!status_list[i].OK()) {
+      status = status_list[i];
+      break;
+    }
+  }
+  return status;
+}
+
+SearchStatus TermDictionary::GetDocFreq(SearchContext *context, FieldID field,
+                                        const std::string &term,
+                                        uint64_t &doc_freq) {
+  std::string key;
+  context->GetConfig()->GetCodec()->EncodeInvertedKey(context->Table(), field,
+                                                      term, key);
+  std::string value;
+  doc_freq = 0;
+  SearchStatus status = context->VDB()->Get(kDictionaryColumn, key, value,
+                                            context->GetSnapshot());
+  if (status.DocumentNotExist()) {
+    return SearchStatus();
+  }
+  if (status.OK()) {
+    int64_t delta = DecodeDocFreq(value);
+    doc_freq = delta > 0 ? delta : 0;
+  }
+  return status;
+}
+
+void TermDictionary::EncodeDocFreq(int64_t delta, std::string &value) {
+  AppendFixed64(value, static_cast<uint64_t>(delta));
+}
+
+int64_t TermDictionary::DecodeDocFreq(const Slice &value) {
+  if (value.size() < sizeof(uint64_t)) return 0;
+  Slice input(value);
+  uint64_t delta = 0;
+  RemoveFixed64(input, delta);
+  return static_cast<int64_t>(delta);
+}
+
+void TermDictionary::MergeDocFreq(const Slice *existing, const Slice &value,
+                                  std::string &new_value) {
+  int64_t doc_freq = DecodeDocFreq(value);
+  if (nullptr != existing) {
+    doc_freq += DecodeDocFreq(*existing);
+  }
+  new_value.clear();
+  EncodeDocFreq(doc_freq, new_value);
+}
+
+}  // namespace wwsearch
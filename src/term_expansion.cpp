@@ -0,0 +1,93 @@
+/*
+ * Tencent is pleased to support the open source community by making wwsearch
+ * available.
+ *
+ * Copyright (C) 2018-present Tencent. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * https://opensource.org/licenses/Apache-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OF ANY KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+#include "term_expansion.h"
+
+namespace wwsearch {
+
+TermExpansion::~TermExpansion() {
+  if (nullptr != or_iterator_) {
+    delete or_iterator_;
+    or_iterator_ = nullptr;
+  }
+
+  if (nullptr != buffer_iterator_) {
+    delete buffer_iterator_;
+    buffer_iterator_ = nullptr;
+  }
+
+  for (auto it : this->iterators_) {
+    assert(nullptr != codec_);
+    codec_->ReleaseDocListReaderCodec(it);
+  }
+  this->iterators_.clear();
+}
+
+void TermExpansion::Init(SearchContext *context, FieldID field_id) {
+  codec_ = context->GetConfig()->GetCodec();
+  field_id_ = field_id;
+  max_heap_terms_ = context->GetConfig()->GetMaxOrHeapIterators();
+}
+
+void TermExpansion::AddDocList(const Slice &value) {
+  if (values_.size() < max_heap_terms_) {
+    values_.emplace_back(value.data(), value.size());
+    return;
+  }
+  AddToBuffer(value.data(), value.size());
+}
+
+void TermExpansion::TakeDocList(std::string &value) {
+  if (values_.size() < max_heap_terms_) {
+    values_.emplace_back();
+    values_.back().swap(value);
+    return;
+  }
+  AddToBuffer(value.c_str(), value.size());
+  value.clear();
+}
+
+// Readers point into values_,so they are created after all adds.
+OrIterator *TermExpansion::Finish() {
+  assert(nullptr == or_iterator_);
+  or_iterator_ = new OrIterator();
+  for (auto &value : values_) {
+    DocListReaderCodec *doc_lists =
+        codec_->NewDocListReaderCodec(value.c_str(), value.size(), field_id_);
+    iterators_.push_back(doc_lists);
+    or_iterator_->AddSubIterator(doc_lists);
+  }
+  if (nullptr != buffer_iterator_) {
+    buffer_iterator_->FinishAddIterator();
+    or_iterator_->AddSubIterator(buffer_iterator_);
+  }
+  or_iterator_->FinishAddIterator();
+  return or_iterator_;
+}
+
+void TermExpansion::AddToBuffer(const char *data, size_t size) {
+  if (nullptr == buffer_iterator_) {
+    buffer_iterator_ = new BufferOrIterator();
+  }
+  DocListReaderCodec *doc_lists =
+      codec_->NewDocListReaderCodec(data, size, field_id_);
+  buffer_iterator_->AddSubIterator(doc_lists);
+  codec_->ReleaseDocListReaderCodec(doc_lists);
+}
+
+}  // namespace wwsearch
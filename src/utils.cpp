@@ -17,6 +17,7 @@
  */
 
 #include "utils.h"
+#include <cstring>
 #include "codec.h"
 #include "codec_doclist_impl.h"
 #include "search_slice.h"
@@ -111,4 +112,22 @@ std::string TrimString(const std::string& str, const std::string& trim) {
   return str.substr(pos);
 }
 
+std::string PrefixSuccessor(const std::string& prefix) {
+  std::string successor(prefix);
+  while (!successor.empty()) {
+    unsigned char last = static_cast<unsigned char>(successor.back());
+    if (last != 0xff) {
+      successor.back() = static_cast<char>(last + 1);
+      return successor;
+    }
+    successor.pop_back();
+  }
+  return successor;
+}
+
+bool HasPrefix(const char* data, size_t size, const std::string& prefix) {
+  return size >= prefix.size() &&
+         0 == memcmp(data, prefix.c_str(), prefix.size());
+}
+
 }  // namespace wwsearch
@@ -18,9 +18,11 @@
 
 #include "virtual_db_mock.h"
 #include <iterator>
+#include "completion_list.h"
 #include "func_scope_guard.h"
 #include "logger.h"
 #include "search_status.h"
+#include "term_dictionary.h"
 #include "utils.h"
 #include "virtual_db_rocks.h"
 #include "write_buffer_mock.h"
@@ -101,6 +103,21 @@ SearchStatus VirtualDBMock::ParsePbString(
         break;
       }
       case lsmsearch::MockData::kMerge: {
+        if (cf == kDictionaryColumn || cf == kMetaColumn) {
+          std::string final_value;
+          if (it != kvs.end()) {
+            Slice existing(it->second);
+            if (cf == kDictionaryColumn) {
+              TermDictionary::MergeDocFreq(&existing, value, final_value);
+            } else {
+              CompletionList::MergeValue(&existing, value, final_value);
+            }
+            it->second = final_value;
+          } else {
+            kvs.emplace(key, value);
+          }
+          break;
+        }
         if (cf != kInvertedIndexColumn) {
           assert(false);
         }
@@ -258,11 +275,16 @@ Iterator* VirtualDBMock::NewIterator(StorageColumnType column,
     KvList kv_list_;
     KvList::iterator iter_;
     std::function<std::string(const std::string&)> func_;
+    std::string upper_bound_;
 
    public:
     MockIterator(const KvList& kv_list,
-                 const std::function<std::string(const std::string&)>& func)
-        : kv_list_(kv_list), iter_(kv_list_.end()), func_(func) {
+                 const std::function<std::string(const std::string&)>& func,
+                 const std::string& upper_bound)
+        : kv_list_(kv_list),
+          iter_(kv_list_.end()),
+          func_(func),
+          upper_bound_(upper_bound) {
       // for (auto& kv : kv_list_) {
       //  SearchLogDebug("kv {[%d %s] => [%d %s]}", kv.first.size(),
       //                 func_(kv.first).c_str(), kv.second.size(),
@@ -273,7 +295,10 @@ Iterator* VirtualDBMock::NewIterator(StorageColumnType column,
 
     ~MockIterator() {}
 
-    bool Valid() const override { return iter_ != kv_list_.end(); }
+    bool Valid() const override {
+      if (iter_ == kv_list_.end()) return false;
+      return upper_bound_.empty() || iter_->first < upper_bound_;
+    }
 
     void SeekToFirst() override { iter_ = kv_list_.begin(); }
 
@@ -304,7 +329,8 @@ Iterator* VirtualDBMock::NewIterator(StorageColumnType column,
     SearchStatus status() const override { return SearchStatus(); }
   };
   std::lock_guard<std::mutex> guard(mut_);
-  return new MockIterator(cf_kv_list_[column], cf_debug_string_funcs_[column]);
+  return new MockIterator(cf_kv_list_[column], cf_debug_string_funcs_[column],
+                          options->iterate_upper_bound_);
 }
 
 // mock api
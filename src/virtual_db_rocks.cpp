@@ -747,6 +747,16 @@ rocksdb::ColumnFamilyOptions VirtualDBRocksImpl::NewColumnFamilyOptions(
       merger_ = DocListMergeOperator::NewInstance(this->params_);
       cf_options.merge_operator.reset(merger_);
       break;
+    case kMetaColumn:
+      cf_options.merge_operator.reset(new CompletionMergeOperator());
+      break;
+    case kDictionaryColumn: {
+      // stateless,shared by all instances.
+      static DocFreqCompactionFilter doc_freq_filter;
+      cf_options.merge_operator.reset(new DocFreqMergeOperator());
+      cf_options.compaction_filter = &doc_freq_filter;
+      break;
+    }
     default:
       break;
   }
@@ -769,10 +779,19 @@ Iterator* VirtualDBRocksImpl::NewIterator(StorageColumnType column,
 
   if (column >= this->column_famil_handles_.size()) return nullptr;
 
+  std::unique_ptr<std::string> upper_bound;
+  std::unique_ptr<rocksdb::Slice> upper_bound_slice;
+  if (!options->iterate_upper_bound_.empty()) {
+    upper_bound.reset(new std::string(options->iterate_upper_bound_));
+    upper_bound_slice.reset(new rocksdb::Slice(*upper_bound));
+    rocks_options.iterate_upper_bound = upper_bound_slice.get();
+  }
+
   auto rocks_iterator = this->db_->NewIterator(
       rocks_options, this->column_famil_handles_[column]);
   if (nullptr == rocks_iterator) return nullptr;
-  return new IteratorRocks(rocks_iterator);
+  return new IteratorRocks(rocks_iterator, std::move(upper_bound),
+                           std::move(upper_bound_slice));
 }
 
 SearchStatus VirtualDBRocksImpl::CompactRange(StorageColumnType column,
@@ -0,0 +1,73 @@
+/*
+ * Tencent is pleased to support the open source community by making wwsearch
+ * available.
+ *
+ * Copyright (C) 2018-present Tencent. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * https://opensource.org/licenses/Apache-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OF ANY KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+#include "wildcard_query.h"
+#include "levenshtein_automaton.h"
+#include "wildcard_weight.h"
+
+namespace wwsearch {
+
+WildcardQuery::WildcardQuery(FieldID field_id, const std::string &pattern,
+                             uint32_t max_expansion_terms)
+    : field_id_(field_id),
+      pattern_(pattern),
+      max_expansion_terms_(max_expansion_terms) {
+  if (!LevenshteinAutomaton::DecodeUTF8(pattern, pattern_code_points_)) {
+    // not utf-8,match bytes.
+    pattern_code_points_.assign(pattern.begin(), pattern.end());
+  }
+  literal_prefix_ = pattern.substr(0, pattern.find_first_of("*?"));
+}
+
+WildcardQuery::~WildcardQuery() {}
+
+Weight *WildcardQuery::CreateWeight(SearchContext *context, bool needs_scores,
+                                    double boost) {
+  return new WildcardWeight(this);
+}
+
+// Greedy match,on mismatch retry from last '*' consuming one more code
+// point.O(n*m) in worst case,linear for usual patterns.
+bool WildcardQuery::Match(const std::string &term) {
+  std::vector<uint32_t> text;
+  if (!LevenshteinAutomaton::DecodeUTF8(term, text)) {
+    text.assign(term.begin(), term.end());
+  }
+  const std::vector<uint32_t> &pattern = pattern_code_points_;
+  size_t p = 0, t = 0;
+  size_t star = std::string::npos, star_text = 0;
+  while (t < text.size()) {
+    if (p < pattern.size() && pattern[p] == '*') {
+      star = p++;
+      star_text = t;
+    } else if (p < pattern.size() &&
+               (pattern[p] == '?' || pattern[p] == text[t])) {
+      p++;
+      t++;
+    } else if (star != std::string::npos) {
+      p = star + 1;
+      t = ++star_text;
+    } else {
+      return false;
+    }
+  }
+  while (p < pattern.size() && pattern[p] == '*') p++;
+  return p == pattern.size();
+}
+
+}  // namespace wwsearch
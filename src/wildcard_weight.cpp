@@ -0,0 +1,138 @@
+/*
+ * Tencent is pleased to support the open source community by making wwsearch
+ * available.
+ *
+ * Copyright (C) 2018-present Tencent. All Rights Reserved.
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License"); you may not
+ * use this file except in compliance with the License. You may obtain a copy of
+ * the License at
+ *
+ * https://opensource.org/licenses/Apache-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS, WITHOUT
+ * WARRANTIES OF ANY KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations under the License.
+ */
+
+#include "wildcard_weight.h"
+#include <algorithm>
+#include "logger.h"
+#include "prefix_scorer.h"
+#include "storage_type.h"
+#include "term_dictionary.h"
+#include "utils.h"
+
+namespace wwsearch {
+
+WildcardWeight::WildcardWeight(WildcardQuery *query)
+    : Weight(query, "WildcardWeight"), codec_(nullptr) {}
+
+WildcardWeight::~WildcardWeight() {}
+
+// Only terms sharing literal prefix of pattern are walked.
+Scorer *WildcardWeight::GetScorer(SearchContext *context) {
+  WildcardQuery *wildcard_query =
+      reinterpret_cast<WildcardQuery *>(this->GetQuery());
+  codec_ = context->GetConfig()->GetCodec();
+
+  std::vector<std::string> doc_lists;
+  if (context->GetConfig()->UseTermDictionary()) {
+    MatchByDictionary(context, doc_lists);
+  } else {
+    MatchByInvertedIndex(context, doc_lists);
+  }
+
+  expansion_.Init(context, wildcard_query->GetFieldID());
+  for (auto &doc_list : doc_lists) {
+    expansion_.TakeDocList(doc_list);
+  }
+  return new PrefixScorer(this, expansion_.Finish());
+}
+
+void WildcardWeight::MatchByInvertedIndex(
+    SearchContext *context, std::vector<std::string> &doc_lists) {
+  WildcardQuery *wildcard_query =
+      reinterpret_cast<WildcardQuery *>(this->GetQuery());
+  std::string field_key;
+  codec_->EncodeInvertedKey(context->Table(), wildcard_query->GetFieldID(),
+                            "", field_key);
+  std::string prefix_key = field_key + wildcard_query->LiteralPrefix();
+  VirtualDBReadOption options;
+  options.snapshot_ = context->GetSnapshot();
+  options.iterate_upper_bound_ = PrefixSuccessor(prefix_key);
+  auto iterator = context->VDB()->NewIterator(kInvertedIndexColumn, &options);
+
+  uint32_t scan_count = 0;
+  for (iterator->Seek(prefix_key); iterator->Valid(); iterator->Next()) {
+    if (context->Interrupted()) break;
+    Slice key = iterator->key();
+    if (!HasPrefix(key.data(), key.size(), prefix_key)) break;
+    scan_count++;
+    std::string term(key.data() + field_key.size(),
+                     key.size() - field_key.size());
+    if (!wildcard_query->Match(term)) continue;
+    if (ReachExpansionLimit(context, doc_lists.size())) break;
+    Slice value = iterator->value();
+    doc_lists.emplace_back(value.data(), value.size());
+  }
+  delete iterator;
+  SearchLogDebug("wildcard pattern=%s match=%u scan=%u",
+                 wildcard_query->Pattern().c_str(), doc_lists.size(),
+                 scan_count);
+}
+
+// Terms are matched before any doc list is read.
+void WildcardWeight::MatchByDictionary(SearchContext *context,
+                                       std::vector<std::string> &doc_lists) {
+  WildcardQuery *wildcard_query =
+      reinterpret_cast<WildcardQuery *>(this->GetQuery());
+  const std::string &prefix = wildcard_query->LiteralPrefix();
+  std::vector<std::string> terms;
+  TermDictionary dictionary(context, wildcard_query->GetFieldID());
+  for (dictionary.Seek(prefix); dictionary.Valid(); dictionary.Next()) {
+    if (context->Interrupted()) break;
+    const std::string &term = dictionary.Term();
+    if (!HasPrefix(term.c_str(), term.size(), prefix)) break;
+    if (!wildcard_query->Match(term)) continue;
+    if (ReachExpansionLimit(context, terms.size())) break;
+    terms.push_back(term);
+  }
+
+  SearchStatus status = dictionary.ReadDocLists(terms, doc_lists);
+  if (!status.OK()) {
+    context->Status() = status;
+    doc_lists.clear();
+    return;
+  }
+  doc_lists.erase(std::remove_if(doc_lists.begin(), doc_lists.end(),
+                                 [](const std::string &doc_list) {
+                                   return doc_list.empty();
+                                 }),
+                  doc_lists.end());
+  SearchLogDebug("wildcard pattern=%s match=%u by dictionary",
+                 wildcard_query->Pattern().c_str(), terms.size());
+}
+
+bool WildcardWeight::ReachExpansionLimit(SearchContext *context,
+                                         size_t term_count) {
+  WildcardQuery *wildcard_query =
+      reinterpret_cast<WildcardQuery *>(this->GetQuery());
+  if (term_count < wildcard_query->MaxExpansionTerms()) {
+    return false;
+  }
+  char buf[128];
+  snprintf(buf, sizeof(buf),
+           "WildcardWeight::GetScorer MaxExpansionTerms(%u) reached",
+           wildcard_query->MaxExpansionTerms());
+  SearchLogError("%s", buf);
+  context->Status().SetStatus(kReachMaxExpansionTermsLimit, buf);
+  return true;
+}
+
+BulkScorer *WildcardWeight::GetBulkScorer(SearchContext *context) {
+  return nullptr;
+}
+
+}  // namespace wwsearch
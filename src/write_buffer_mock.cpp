@@ -17,8 +17,10 @@
  */
 
 #include "write_buffer_mock.h"
+#include "completion_list.h"
 #include "func_scope_guard.h"
 #include "logger.h"
+#include "term_dictionary.h"
 #include "utils.h"
 
 namespace wwsearch {
@@ -124,14 +126,7 @@ SearchStatus WriteBufferMock::DeSeriableData() {
                 "RocksDBErrorStatus WriteBufferMock::Append");
   }
   if (s.OK()) {
-    for (size_t i = 0; i < data_list.mock_data_list_size(); ++i) {
-      const lsmsearch::MockData& mock_data = data_list.mock_data_list(i);
-      s = Put(static_cast<StorageColumnType>(mock_data.column_type()),
-              mock_data.key(), mock_data.value());
-      if (!s.OK()) {
-        break;
-      }
-    }
+    s = Replay(data_list);
   }
   return s;
 }
@@ -144,6 +139,22 @@ SearchStatus WriteBufferMock::Merge(StorageColumnType column,
   SearchStatus s;
   KvList& kvs = cf_kv_list_[column];
   auto iter = kvs.find(key);
+  if (column == kDictionaryColumn || column == kMetaColumn) {
+    if (iter != kvs.end()) {
+      Slice existing(iter->second.first);
+      std::string final_value;
+      if (column == kDictionaryColumn) {
+        TermDictionary::MergeDocFreq(&existing, value, final_value);
+      } else {
+        CompletionList::MergeValue(&existing, value, final_value);
+      }
+      iter->second.first = final_value;
+    } else {
+      kvs.emplace(key, std::make_pair(value, lsmsearch::MockData::kMerge));
+      kv_cnt_++;
+    }
+    return s;
+  }
   if (column != kInvertedIndexColumn) {
     assert(false);
   }
@@ -225,6 +236,12 @@ SearchStatus WriteBufferMock::Append(WriteBuffer* prepare_append_write_buffer) {
                 "RocksDBErrorStatus WriteBufferMock::Append");
     return s;
   }
+  return Replay(data_list);
+}
+
+SearchStatus WriteBufferMock::Replay(
+    const lsmsearch::MockDataList& data_list) {
+  SearchStatus s;
   for (size_t i = 0; i < data_list.mock_data_list_size(); ++i) {
     const lsmsearch::MockData& mock_data = data_list.mock_data_list(i);
     StorageColumnType cf =
@@ -236,7 +253,8 @@ SearchStatus WriteBufferMock::Append(WriteBuffer* prepare_append_write_buffer) {
         break;
       }
       case lsmsearch::MockData::kMerge: {
-        if (cf != kInvertedIndexColumn) {
+        if (cf != kInvertedIndexColumn && cf != kDictionaryColumn &&
+            cf != kMetaColumn) {
           assert(false);
         }
         s = Merge(cf, mock_data.key(), mock_data.value());
@@ -246,6 +264,10 @@ SearchStatus WriteBufferMock::Append(WriteBuffer* prepare_append_write_buffer) {
         s = Delete(cf, mock_data.key());
         break;
       }
+      case lsmsearch::MockData::kDeleteRange: {
+        s = DeleteRange(cf, mock_data.key(), mock_data.end_key());
+        break;
+      }
       default:
         assert(false);
     }
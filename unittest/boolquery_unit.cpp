@@ -17,9 +17,18 @@
  */
 
 #include <gtest/gtest.h>
+#include "include/and_query.h"
+#include "include/fuzzy_query.h"
 #include "include/index_wrapper.h"
+#include "include/levenshtein_automaton.h"
+#include "include/numeric_range_query.h"
 #include "include/prefix_query.h"
+#include "include/query_rewriter.h"
+#include "include/search_context.h"
 #include "include/search_util.h"
+#include "include/term_dictionary.h"
+#include "include/virtual_db_rocks.h"
+#include "include/wildcard_query.h"
 #include "unittest_util.h"
 
 extern bool g_debug;
@@ -237,6 +246,224 @@ TEST_F(BoolQueryTest, PrefixQuery) {
   }
 }
 
+TEST_F(BoolQueryTest, FuzzyQuery) {
+  auto base = GetNumeric(10000);
+  const char *words[] = {"fuzzyjonathan", "fuzzyjohnathan", "fuzzyjonatan",
+                         "fuzzyjanathon", "fuzzyxyz", "fuzzyjonathanxyz"};
+  std::vector<DocumentID> ids;
+  for (auto word : words) {
+    ids.push_back(GetDocumentID());
+    documents.push_back(
+        TestUtil::NewDocument(ids.back(), word, base, base + 100, base + 69));
+  }
+  bool ret = index->index_writer_->AddOrUpdateDocuments(table, documents,
+                                                        nullptr, nullptr);
+  EXPECT_TRUE(ret);
+
+  wwsearch::Searcher searcher(&index->Config());
+  auto run = [&](uint32_t max_edits, uint32_t max_expansion_terms) {
+    match_documentsid.clear();
+    wwsearch::FuzzyQuery query(1, "fuzzyjonathan", max_edits,
+                               max_expansion_terms);
+    auto status = searcher.DoQuery(table, query, 0, 100, nullptr, nullptr,
+                                   match_documentsid);
+    EXPECT_EQ(0, status.GetCode());
+    std::set<DocumentID> match(match_documentsid.begin(),
+                               match_documentsid.end());
+    return match;
+  };
+  EXPECT_EQ(std::set<DocumentID>({ids[0]}), run(0, 50));
+  EXPECT_EQ(std::set<DocumentID>({ids[0], ids[1], ids[2]}), run(1, 50));
+  EXPECT_EQ(std::set<DocumentID>({ids[0], ids[1], ids[2], ids[3]}),
+            run(2, 50));
+  // closest term is kept.
+  EXPECT_EQ(std::set<DocumentID>({ids[0]}), run(2, 1));
+
+  // automaton works on code points.
+  LevenshteinAutomaton automaton("张三丰", 1);
+  uint32_t distance = 0;
+  std::string seek;
+  EXPECT_TRUE(automaton.Accept("张三风", distance, seek));
+  EXPECT_EQ(1, distance);
+  EXPECT_TRUE(automaton.Accept("张三", distance, seek));
+  EXPECT_FALSE(automaton.Accept("李四丰", distance, seek));
+  // 李四 can not match,smallest greater term which may match is 李张.
+  EXPECT_EQ("李张", seek);
+  EXPECT_FALSE(automaton.Accept("三丰张", distance, seek));
+  EXPECT_FALSE(automaton.Accept("王五", distance, seek));
+}
+
+TEST_F(BoolQueryTest, WildcardQuery) {
+  // dictionary is written too,both ways are checked.
+  index->Config().SetTermDictionary(true);
+  auto base = GetNumeric(10000);
+  const char *words[] = {"wildapple", "wildgrape", "wildpineapple",
+                         "wildapricot"};
+  std::vector<DocumentID> ids;
+  for (auto word : words) {
+    ids.push_back(GetDocumentID());
+    documents.push_back(
+        TestUtil::NewDocument(ids.back(), word, base, base + 100, base + 69));
+  }
+  bool ret = index->index_writer_->AddOrUpdateDocuments(table, documents,
+                                                        nullptr, nullptr);
+  EXPECT_TRUE(ret);
+  index->Config().SetTermDictionary(false);
+
+  wwsearch::Searcher searcher(&index->Config());
+  auto run = [&](const std::string &pattern) {
+    match_documentsid.clear();
+    wwsearch::WildcardQuery query(1, pattern);
+    auto status = searcher.DoQuery(table, query, 0, 100, nullptr, nullptr,
+                                   match_documentsid);
+    EXPECT_EQ(0, status.GetCode());
+    return std::set<DocumentID>(match_documentsid.begin(),
+                                match_documentsid.end());
+  };
+  // infix without suffix terms.
+  EXPECT_EQ(std::set<DocumentID>({ids[0], ids[2]}), run("*apple"));
+  EXPECT_EQ(std::set<DocumentID>({ids[0], ids[1], ids[2], ids[3]}),
+            run("*ap*"));
+  EXPECT_EQ(std::set<DocumentID>({ids[0]}), run("wild?pple"));
+  EXPECT_EQ(std::set<DocumentID>({ids[3]}), run("wild*t"));
+  EXPECT_EQ(std::set<DocumentID>(), run("wild?apple"));
+
+  index->Config().SetTermDictionary(true);
+  EXPECT_EQ(std::set<DocumentID>({ids[0], ids[2]}), run("*apple"));
+  EXPECT_EQ(std::set<DocumentID>({ids[3]}), run("wild*t"));
+  index->Config().SetTermDictionary(false);
+
+  wwsearch::WildcardQuery query(1, "a*b?c");
+  EXPECT_EQ("a", query.LiteralPrefix());
+  EXPECT_TRUE(query.Match("ab*bxc"));
+  EXPECT_TRUE(query.Match("abxc"));
+  EXPECT_FALSE(query.Match("abc"));
+  // '?' matches one code point.
+  wwsearch::WildcardQuery chinese_query(1, "张?丰");
+  EXPECT_TRUE(chinese_query.Match("张三丰"));
+  EXPECT_FALSE(chinese_query.Match("张丰"));
+}
+
+TEST_F(BoolQueryTest, TermDictionary) {
+  index->Config().SetTermDictionary(true);
+  auto base = GetNumeric(10000);
+  const char *words[] = {"dictapple", "dictapple", "dictapply"};
+  std::vector<DocumentID> ids;
+  for (auto word : words) {
+    ids.push_back(GetDocumentID());
+    documents.push_back(
+        TestUtil::NewDocument(ids.back(), word, base, base + 100, base + 69));
+  }
+  bool ret = index->index_writer_->AddOrUpdateDocuments(table, documents,
+                                                        nullptr, nullptr);
+  EXPECT_TRUE(ret);
+
+  SearchContext context(table, index->vdb_, nullptr, &index->Config());
+  auto doc_freq = [&](const std::string &term) {
+    uint64_t freq = 0;
+    auto status = TermDictionary::GetDocFreq(&context, 1, term, freq);
+    EXPECT_EQ(0, status.GetCode());
+    return freq;
+  };
+  EXPECT_EQ(2, doc_freq("dictapple"));
+  EXPECT_EQ(1, doc_freq("dictapply"));
+
+  // update and delete adjust doc frequency.
+  std::vector<DocumentUpdater *> changes;
+  changes.push_back(
+      TestUtil::NewDocument(ids[1], "dictapricot", base, base + 100, base));
+  ret = index->index_writer_->AddOrUpdateDocuments(table, changes, nullptr,
+                                                   nullptr);
+  EXPECT_TRUE(ret);
+  changes.push_back(
+      TestUtil::NewDocument(ids[2], "dictapply", base, base + 100, base));
+  std::vector<DocumentUpdater *> deletes(1, changes.back());
+  ret = index->index_writer_->DeleteDocuments(table, deletes, nullptr,
+                                              nullptr);
+  EXPECT_TRUE(ret);
+  for (auto du : changes) {
+    EXPECT_EQ(0, du->Status().GetCode());
+    delete du;
+  }
+  EXPECT_EQ(1, doc_freq("dictapple"));
+  EXPECT_EQ(1, doc_freq("dictapricot"));
+  EXPECT_EQ(0, doc_freq("dictapply"));
+
+  // dead term is skipped.
+  std::vector<std::string> terms;
+  TermDictionary dictionary(&context, 1);
+  for (dictionary.Seek("dict"); dictionary.Valid(); dictionary.Next()) {
+    if (0 != dictionary.Term().compare(0, 4, "dict")) break;
+    terms.push_back(dictionary.Term());
+  }
+  EXPECT_EQ(std::vector<std::string>({"dictapple", "dictapricot"}), terms);
+
+  // and compaction drops it.
+  DocFreqCompactionFilter filter;
+  for (int64_t freq : {-1, 0, 1}) {
+    std::string value, new_value;
+    bool value_changed = false;
+    TermDictionary::EncodeDocFreq(freq, value);
+    EXPECT_EQ(freq <= 0,
+              filter.Filter(0, rocksdb::Slice("dictapply"),
+                            rocksdb::Slice(value), &new_value,
+                            &value_changed));
+  }
+
+  // And probes rare term first,the first sub query is kept.
+  {
+    wwsearch::BooleanQuery query1(1, "dictapricot");
+    wwsearch::BooleanQuery query2(1, "dictapple");
+    wwsearch::BooleanQuery query3(1, "dictapply");
+    wwsearch::AndQuery query;
+    query.AddQuery(&query1);
+    query.AddQuery(&query2);
+    query.AddQuery(&query3);
+    QueryRewriter rewriter(&context);
+    AndQuery *rewrite_query =
+        dynamic_cast<AndQuery *>(rewriter.Rewrite(&query));
+    ASSERT_NE(nullptr, rewrite_query);
+    ASSERT_EQ(3, rewrite_query->SubQuery().size());
+    EXPECT_EQ(&query1, rewrite_query->SubQuery()[0]);
+    EXPECT_EQ(&query3, rewrite_query->SubQuery()[1]);
+    EXPECT_EQ(&query2, rewrite_query->SubQuery()[2]);
+  }
+
+  // expansion walks dictionary.
+  wwsearch::Searcher searcher(&index->Config());
+  {
+    wwsearch::PrefixQuery query(1, "dictap");
+    auto status = searcher.DoQuery(table, query, 0, 100, nullptr, nullptr,
+                                   match_documentsid);
+    EXPECT_EQ(0, status.GetCode());
+    EXPECT_EQ(std::set<DocumentID>({ids[0], ids[1]}),
+              std::set<DocumentID>(match_documentsid.begin(),
+                                   match_documentsid.end()));
+  }
+  {
+    match_documentsid.clear();
+    wwsearch::FuzzyQuery query(1, "dictapple", 1);
+    auto status = searcher.DoQuery(table, query, 0, 100, nullptr, nullptr,
+                                   match_documentsid);
+    EXPECT_EQ(0, status.GetCode());
+    EXPECT_EQ(std::list<DocumentID>({ids[0]}), match_documentsid);
+  }
+
+  // re-ingested docs are counted once.
+  for (size_t docs : {2, 3, 3}) {
+    InvertIndexItemList indices;
+    InvertIndexItem *item = indices.AddItem();
+    item->Set(1, "dictingest");
+    for (size_t i = 0; i < docs; i++) {
+      item->AddDocID(ids[i]);
+    }
+    EXPECT_TRUE(index->index_writer_->IngestInvertIndex(table, indices,
+                                                        nullptr));
+    EXPECT_EQ(docs, doc_freq("dictingest"));
+  }
+  index->Config().SetTermDictionary(false);
+}
+
 TEST_F(BoolQueryTest, Query_Chinese) {
   auto base = GetNumeric(10000);
   auto document_updater = TestUtil::NewDocument(
@@ -340,6 +567,152 @@ TEST_F(BoolQueryTest, Query_Numeric) {
   }
 }
 
+TEST_F(BoolQueryTest, Query_NumericRange) {
+  std::vector<uint64_t> values;
+  for (uint64_t i = 0; i < 200; i++) {
+    values.push_back(i * 997 + (i % 7) * 65536);
+  }
+  for (auto value : values) {
+    DocumentUpdater *du = new DocumentUpdater();
+    Document &document = du->New();
+    document.SetID(GetDocumentID());
+    IndexField *field = document.AddField();
+    InitUint64Field(field, 20, value);
+    field->Flag().SetNumericTrie();
+    field = document.AddField();
+    InitUint32Field(field, 21, value);
+    field->Flag().SetNumericTrie();
+    documents.push_back(du);
+  }
+  bool ret = index->index_writer_->AddOrUpdateDocuments(table, documents,
+                                                        nullptr, nullptr);
+  EXPECT_TRUE(ret);
+  for (auto du : documents) {
+    EXPECT_EQ(0, du->Status().GetCode());
+  }
+
+  wwsearch::Searcher searcher(&index->Config());
+  std::vector<std::pair<uint64_t, uint64_t>> ranges{
+      {0, 0},           {0, 1000000},  {255, 256},    {997, 997 * 3},
+      {1000, 150000},   {65535, 65537}, {70000, 70000}, {0, UINT32_MAX},
+      {123456, 654321}, {300000, 100}};
+  for (auto &range : ranges) {
+    size_t expect = 0;
+    for (auto value : values) {
+      if (value >= range.first && value <= range.second) expect++;
+    }
+
+    match_documentsid.clear();
+    NumericRangeQuery query64(20, range.first, range.second);
+    auto status = searcher.DoQuery(table, query64, 0, 1000, nullptr, nullptr,
+                                   match_documentsid);
+    EXPECT_EQ(0, status.GetCode());
+    EXPECT_EQ(expect, match_documentsid.size());
+
+    match_documentsid.clear();
+    NumericRangeQuery query32(21, static_cast<uint32_t>(range.first),
+                              static_cast<uint32_t>(range.second));
+    status = searcher.DoQuery(table, query32, 0, 1000, nullptr, nullptr,
+                              match_documentsid);
+    EXPECT_EQ(0, status.GetCode());
+    EXPECT_EQ(expect, match_documentsid.size());
+
+    // full precision terms scan
+    match_documentsid.clear();
+    NumericRangeQuery scan_query(20, range.first, range.second, false);
+    status = searcher.DoQuery(table, scan_query, 0, 1000, nullptr, nullptr,
+                              match_documentsid);
+    EXPECT_EQ(0, status.GetCode());
+    EXPECT_EQ(expect, match_documentsid.size());
+  }
+
+  // lower precision terms of old value must be removed.
+  {
+    DocumentUpdater *du = new DocumentUpdater();
+    Document &document = du->New();
+    document.SetID(documents.front()->New().ID());
+    IndexField *field = document.AddField();
+    InitUint64Field(field, 20, 1ULL << 40);
+    field->Flag().SetNumericTrie();
+    std::vector<DocumentUpdater *> update_documents{du};
+    ret = index->index_writer_->AddOrUpdateDocuments(table, update_documents,
+                                                     nullptr, nullptr);
+    EXPECT_TRUE(ret);
+    delete du;
+
+    match_documentsid.clear();
+    NumericRangeQuery query(20, values.front(), values.front() + 255);
+    auto status = searcher.DoQuery(table, query, 0, 1000, nullptr, nullptr,
+                                   match_documentsid);
+    EXPECT_EQ(0, status.GetCode());
+    EXPECT_EQ(0, match_documentsid.size());
+
+    match_documentsid.clear();
+    NumericRangeQuery new_query(20, 1ULL << 39, UINT64_MAX);
+    status = searcher.DoQuery(table, new_query, 0, 1000, nullptr, nullptr,
+                              match_documentsid);
+    EXPECT_EQ(0, status.GetCode());
+    EXPECT_EQ(1, match_documentsid.size());
+  }
+}
+
+TEST_F(BoolQueryTest, Query_DocListCache) {
+  DocListCache cache(1 << 20, 4);
+  index->Config().SetDocListCache(&cache);
+  auto base = GetNumeric(10000);
+  for (int i = 0; i < 10; i++) {
+    documents.push_back(TestUtil::NewDocument(GetDocumentID(), "hotterm", base,
+                                              base + 100, base));
+  }
+  documents.push_back(TestUtil::NewDocument(GetDocumentID(), "coldterm", base,
+                                            base + 100, base));
+  bool ret = index->index_writer_->AddOrUpdateDocuments(table, documents,
+                                                        nullptr, nullptr);
+  EXPECT_TRUE(ret);
+
+  wwsearch::Searcher searcher(&index->Config());
+  wwsearch::BooleanQuery hot_query(1, "hotterm");
+  wwsearch::BooleanQuery cold_query(1, "coldterm");
+  std::list<DocumentID> expect_documentsid;
+  auto status = searcher.DoQuery(table, hot_query, 0, 100, nullptr, nullptr,
+                                 expect_documentsid);
+  EXPECT_EQ(0, status.GetCode());
+  EXPECT_EQ(10, expect_documentsid.size());
+  EXPECT_GT(cache.UsageBytes(), 0);
+
+  status = searcher.DoQuery(table, hot_query, 0, 100, nullptr, nullptr,
+                            match_documentsid);
+  EXPECT_EQ(0, status.GetCode());
+  EXPECT_EQ(1, cache.Hits());
+  EXPECT_EQ(expect_documentsid, match_documentsid);
+
+  // small list is not admitted.
+  for (int i = 0; i < 2; i++) {
+    match_documentsid.clear();
+    status = searcher.DoQuery(table, cold_query, 0, 100, nullptr, nullptr,
+                              match_documentsid);
+    EXPECT_EQ(0, status.GetCode());
+    EXPECT_EQ(1, match_documentsid.size());
+  }
+  EXPECT_EQ(1, cache.Hits());
+
+  // new version after write.
+  DocumentUpdater *du = TestUtil::NewDocument(GetDocumentID(), "hotterm", base,
+                                              base + 100, base);
+  std::vector<DocumentUpdater *> new_documents{du};
+  ret = index->index_writer_->AddOrUpdateDocuments(table, new_documents,
+                                                   nullptr, nullptr);
+  EXPECT_TRUE(ret);
+  documents.push_back(du);
+  match_documentsid.clear();
+  status = searcher.DoQuery(table, hot_query, 0, 100, nullptr, nullptr,
+                            match_documentsid);
+  EXPECT_EQ(0, status.GetCode());
+  EXPECT_EQ(11, match_documentsid.size());
+  EXPECT_EQ(1, cache.Hits());
+  index->Config().SetDocListCache(nullptr);
+}
+
 TEST_F(BoolQueryTest, TextQueryUsingTokenize) {
   auto base = GetNumeric(10000);
   const std::string doc_text1{
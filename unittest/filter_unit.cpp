@@ -17,6 +17,7 @@
  */
 
 #include <gtest/gtest.h>
+#include "include/filter_pushdown.h"
 #include "include/index_wrapper.h"
 #include "include/search_util.h"
 #include "unittest_util.h"
@@ -370,4 +371,94 @@ TEST_F(FilterTest, Filters) {
   }
 }
 
+TEST_F(FilterTest, FilterPushdown) {
+  for (uint32_t i = 0; i < 50; i++) {
+    DocumentUpdater* du = new DocumentUpdater();
+    Document& document = du->New();
+    document.SetID(GetDocumentID());
+    InitStringField(document.AddField(), 1, "pushdown");
+    IndexField* field = document.AddField();
+    InitUint32Field(field, 2, i * 10);
+    field->Flag().SetNumericTrie();
+    InitUint64Field(document.AddField(), 3, i % 5);
+    field = document.AddField();
+    IndexFieldFlag flag;
+    flag.SetDocValue();
+    flag.SetInvertIndex();
+    field->SetMeta(4, flag);
+    field->SetString(i % 2 == 0 ? "even" : "odd");
+    documents.push_back(du);
+  }
+  bool ret = index->index_writer_->AddOrUpdateDocuments(table, documents,
+                                                        nullptr, nullptr);
+  EXPECT_TRUE(ret);
+
+  // indexed: flag filter's field as inverted indexed,could push down.
+  auto build_filters = [](bool indexed, std::vector<Filter*>& filters) {
+    IndexFieldFlag flag;
+    if (indexed) {
+      flag.SetInvertIndex();
+      flag.SetNumericTrie();
+    }
+    EqualFilter* equal = new EqualFilter();
+    equal->GetField()->SetMeta(3, flag);
+    equal->GetField()->SetUint64(2);
+    filters.push_back(equal);
+
+    RangeFilter* range = new RangeFilter(75, 420);
+    range->GetField()->SetMeta(2, flag);
+    range->GetField()->SetUint32(0);
+    filters.push_back(range);
+
+    InNumericListFilter* in_list = new InNumericListFilter();
+    in_list->GetField()->SetMeta(3, flag);
+    in_list->GetField()->SetNumericList({1, 2, 2, 4});
+    filters.push_back(in_list);
+
+    EqualFilter* equal_string = new EqualFilter();
+    equal_string->GetField()->SetMeta(4, flag);
+    equal_string->GetField()->SetString("even");
+    filters.push_back(equal_string);
+  };
+
+  wwsearch::Searcher searcher(&index->Config());
+  wwsearch::BooleanQuery query(1, "pushdown");
+  for (uint32_t min_match : {0, 1, 4}) {
+    std::vector<Filter*> docvalue_filters, pushdown_filters;
+    build_filters(false, docvalue_filters);
+    build_filters(true, pushdown_filters);
+
+    std::list<DocumentID> expect_docs;
+    auto status =
+        searcher.DoQuery(table, query, 0, 100, &docvalue_filters, nullptr,
+                         expect_docs, nullptr, SIZE_MAX, min_match);
+    EXPECT_EQ(0, status.GetCode());
+    EXPECT_FALSE(expect_docs.empty());
+
+    status = searcher.DoQuery(table, query, 0, 100, &pushdown_filters,
+                              nullptr, match_documentsid, nullptr, SIZE_MAX,
+                              min_match);
+    EXPECT_EQ(0, status.GetCode());
+    EXPECT_EQ(expect_docs, match_documentsid);
+    match_documentsid.clear();
+
+    FilterPushdown pushdown(&index->Config());
+    std::vector<Filter*>* remain_filter = &pushdown_filters;
+    Query* real_query = pushdown.Plan(&query, remain_filter, min_match);
+    if (min_match == 1) {
+      EXPECT_EQ(&query, real_query);
+      EXPECT_EQ(0, pushdown.PushedFilterNum());
+    } else {
+      EXPECT_NE(&query, real_query);
+      EXPECT_EQ(3, pushdown.PushedFilterNum());
+      // string filter still need check by docvalue
+      ASSERT_NE(nullptr, remain_filter);
+      EXPECT_EQ(1, remain_filter->size());
+    }
+
+    for (auto filter : docvalue_filters) delete filter;
+    for (auto filter : pushdown_filters) delete filter;
+  }
+}
+
 }  // namespace wwsearch
@@ -17,8 +17,11 @@
  */
 
 #include <gtest/gtest.h>
+#include "include/and_not_query.h"
 #include "include/index_wrapper.h"
+#include "include/min_should_match_query.h"
 #include "include/prefix_query.h"
+#include "include/query_rewriter.h"
 #include "include/search_util.h"
 #include "unittest_util.h"
 
@@ -635,4 +638,355 @@ TEST_F(OrAndQueryTest, UsePostScorerForPrefixTextQuery) {
         JoinContainerToString(match_documentsid, ", ").c_str());
   }
 }
+
+TEST_F(OrAndQueryTest, Prefix_Query_Wide) {
+  VariableChange();
+  auto base = GetNumeric(10000);
+  for (char c = 'a'; c <= 't'; c++) {
+    documents.push_back(TestUtil::NewDocument(
+        GetDocumentID(), std::string("widepre") + c, base, base + 100, base));
+  }
+  bool ret = index->index_writer_->AddOrUpdateDocuments(table, documents,
+                                                        nullptr, nullptr);
+  EXPECT_TRUE(ret);
+  for (auto du : documents) {
+    EXPECT_EQ(0, du->Status().GetCode());
+  }
+
+  wwsearch::Searcher searcher(&index->Config());
+  auto old_heap_iterators = index->Config().GetMaxOrHeapIterators();
+  index->Config().SetMaxOrHeapIterators(4);
+
+  {
+    match_documentsid.clear();
+    wwsearch::PrefixQuery query(1, "widepre");
+    auto status = searcher.DoQuery(table, query, 0, 100, nullptr, nullptr,
+                                   match_documentsid);
+    EXPECT_EQ(0, status.GetCode());
+    EXPECT_EQ(20, match_documentsid.size());
+    DocumentID prev = DocIdSetIterator::MAX_DOCID;
+    for (auto doc_id : match_documentsid) {
+      EXPECT_TRUE(doc_id < prev);
+      prev = doc_id;
+    }
+  }
+
+  {
+    match_documentsid.clear();
+    wwsearch::PrefixQuery query(1, "widepre", 1000000, 6);
+    auto status = searcher.DoQuery(table, query, 0, 100, nullptr, nullptr,
+                                   match_documentsid);
+    EXPECT_EQ(kReachMaxExpansionTermsLimit, status.GetCode());
+    EXPECT_EQ(6, match_documentsid.size());
+  }
+
+  index->Config().SetMaxOrHeapIterators(old_heap_iterators);
+}
+
+TEST_F(OrAndQueryTest, Or_Query_Term_At_A_Time) {
+  VariableChange();
+  auto base = GetNumeric(10000);
+  const char *words[] = {"taata", "taatb", "taatc", "taatd", "taate"};
+  for (int i = 0; i < 20; i++) {
+    std::string text = std::string(words[i % 5]) + " " + words[(i + 1) % 5];
+    documents.push_back(
+        TestUtil::NewDocument(GetDocumentID(), text, base, base + 100, base));
+  }
+  documents.push_back(TestUtil::NewDocument(GetDocumentID(), "taatnothing",
+                                            base, base + 100, base));
+  bool ret = index->index_writer_->AddOrUpdateDocuments(table, documents,
+                                                        nullptr, nullptr);
+  EXPECT_TRUE(ret);
+  for (auto du : documents) {
+    EXPECT_EQ(0, du->Status().GetCode());
+  }
+
+  wwsearch::Searcher searcher(&index->Config());
+  auto old_heap_iterators = index->Config().GetMaxOrHeapIterators();
+  std::list<DocumentID> heap_documentsid;
+  for (uint32_t heap_iterators : {100, 1}) {
+    index->Config().SetMaxOrHeapIterators(heap_iterators);
+    match_documentsid.clear();
+    wwsearch::BooleanQuery query1(1, "taata");
+    wwsearch::BooleanQuery query2(1, "taatc");
+    wwsearch::OrQuery query;
+    query.AddQuery(&query1);
+    query.AddQuery(&query2);
+
+    auto status = searcher.DoQuery(table, query, 0, 100, nullptr, nullptr,
+                                   match_documentsid);
+    EXPECT_EQ(0, status.GetCode());
+    EXPECT_EQ(16, match_documentsid.size());
+    if (heap_documentsid.empty()) {
+      heap_documentsid = match_documentsid;
+    } else {
+      EXPECT_TRUE(heap_documentsid == match_documentsid);
+    }
+  }
+  index->Config().SetMaxOrHeapIterators(old_heap_iterators);
+}
+
+TEST_F(OrAndQueryTest, Or_Query_Term_At_A_Time_Multi_Field) {
+  VariableChange();
+  std::map<DocumentID, int> expect;
+  for (int i = 0; i < 10; i++) {
+    FieldID field_id = i % 2 == 0 ? 1 : 2;
+    std::vector<TestUtil::FieldIdStrPair> field_id_str_list{
+        {field_id, field_id == 1 ? "taatfieldone" : "taatfieldtwo"}};
+    DocumentID document_id = GetDocumentID();
+    documents.push_back(
+        TestUtil::NewStringFieldDocument(document_id, field_id_str_list));
+    expect[document_id] = field_id;
+  }
+  bool ret = index->index_writer_->AddOrUpdateDocuments(table, documents,
+                                                        nullptr, nullptr);
+  EXPECT_TRUE(ret);
+
+  // buffer keeps match field of every doc.
+  auto old_heap_iterators = index->Config().GetMaxOrHeapIterators();
+  index->Config().SetMaxOrHeapIterators(1);
+  auto snapshot = index->vdb_->NewSnapshot();
+  SearchContext context(table, index->vdb_, snapshot, &index->Config());
+  wwsearch::BooleanQuery query1(1, "taatfieldone");
+  wwsearch::BooleanQuery query2(2, "taatfieldtwo");
+  wwsearch::OrQuery query;
+  query.AddQuery(&query1);
+  query.AddQuery(&query2);
+  Weight *weight = query.CreateWeight(&context, false, 0);
+  Scorer *scorer = weight->GetScorer(&context);
+  ASSERT_NE(nullptr, scorer);
+  DocIdSetIterator &iterator = scorer->Iterator();
+  size_t count = 0;
+  for (; iterator.DocID() != DocIdSetIterator::NO_MORE_DOCS;
+       iterator.NextDoc()) {
+    auto it = expect.find(iterator.DocID());
+    ASSERT_TRUE(it != expect.end());
+    EXPECT_EQ(it->second, iterator.FieldId());
+    count++;
+  }
+  EXPECT_EQ(expect.size(), count);
+  delete scorer;
+  delete weight;
+  index->vdb_->ReleaseSnapshot(snapshot);
+  index->Config().SetMaxOrHeapIterators(old_heap_iterators);
+}
+
+TEST_F(OrAndQueryTest, Query_Rewrite) {
+  VariableChange();
+  auto base = GetNumeric(10000);
+  const char *words[] = {"rewritea", "rewriteb", "rewritec"};
+  for (int i = 0; i < 20; i++) {
+    std::string text = words[i % 3];
+    if (i % 2 == 0) text += " rewriteall";
+    documents.push_back(
+        TestUtil::NewDocument(GetDocumentID(), text, base, base + 100, base));
+  }
+  bool ret = index->index_writer_->AddOrUpdateDocuments(table, documents,
+                                                        nullptr, nullptr);
+  EXPECT_TRUE(ret);
+  for (auto du : documents) {
+    EXPECT_EQ(0, du->Status().GetCode());
+  }
+
+  wwsearch::Searcher searcher(&index->Config());
+  std::list<DocumentID> expect_documentsid;
+  {
+    wwsearch::BooleanQuery query1(1, "rewritea");
+    wwsearch::BooleanQuery query2(1, "rewriteall");
+    wwsearch::AndQuery query;
+    query.AddQuery(&query1);
+    query.AddQuery(&query2);
+    auto status = searcher.DoQuery(table, query, 0, 100, nullptr, nullptr,
+                                   expect_documentsid);
+    EXPECT_EQ(0, status.GetCode());
+    EXPECT_EQ(4, expect_documentsid.size());
+  }
+
+  auto snapshot = index->vdb_->NewSnapshot();
+  SearchContext context(table, index->vdb_, snapshot, &index->Config());
+  {
+    // and(and(a,all),or(a,a),prefix(all)) -> and(a,all)
+    wwsearch::BooleanQuery query1(1, "rewritea");
+    wwsearch::BooleanQuery query2(1, "rewriteall");
+    wwsearch::BooleanQuery query3(1, "rewritea");
+    wwsearch::PrefixQuery query4(1, "rewriteal");
+    wwsearch::AndQuery inner_and;
+    inner_and.AddQuery(&query1);
+    inner_and.AddQuery(&query2);
+    wwsearch::OrQuery inner_or;
+    inner_or.AddQuery(&query1);
+    inner_or.AddQuery(&query3);
+    wwsearch::AndQuery query;
+    query.AddQuery(&inner_and);
+    query.AddQuery(&inner_or);
+    query.AddQuery(&query4);
+
+    QueryRewriter rewriter(&context);
+    AndQuery *rewrite_query =
+        dynamic_cast<AndQuery *>(rewriter.Rewrite(&query));
+    ASSERT_NE(nullptr, rewrite_query);
+    ASSERT_EQ(2, rewrite_query->SubQuery().size());
+    EXPECT_EQ(&query1, rewrite_query->SubQuery()[0]);
+    EXPECT_EQ(&query2, rewrite_query->SubQuery()[1]);
+
+    match_documentsid.clear();
+    auto status = searcher.DoQuery(table, query, 0, 100, nullptr, nullptr,
+                                   match_documentsid);
+    EXPECT_EQ(0, status.GetCode());
+    EXPECT_TRUE(expect_documentsid == match_documentsid);
+  }
+
+  {
+    // empty prefix goes first
+    wwsearch::BooleanQuery query1(1, "rewriteb");
+    wwsearch::PrefixQuery query2(1, "rewritebb");
+    wwsearch::PrefixQuery query3(1, "rewrite");
+    wwsearch::AndQuery query;
+    query.AddQuery(&query1);
+    query.AddQuery(&query3);
+    query.AddQuery(&query2);
+
+    QueryRewriter rewriter(&context);
+    AndQuery *rewrite_query =
+        dynamic_cast<AndQuery *>(rewriter.Rewrite(&query));
+    ASSERT_NE(nullptr, rewrite_query);
+    ASSERT_EQ(3, rewrite_query->SubQuery().size());
+    EXPECT_EQ(&query2, rewrite_query->SubQuery()[0]);
+
+    match_documentsid.clear();
+    auto status = searcher.DoQuery(table, query, 0, 100, nullptr, nullptr,
+                                   match_documentsid);
+    EXPECT_EQ(0, status.GetCode());
+    EXPECT_EQ(0, match_documentsid.size());
+  }
+  index->vdb_->ReleaseSnapshot(snapshot);
+}
+
+TEST_F(OrAndQueryTest, And_Not_Query) {
+  VariableChange();
+  auto base = GetNumeric(10000);
+  std::list<DocumentID> expect_x, expect_xy;
+  for (int i = 0; i < 20; i++) {
+    std::string text = "andnotall";
+    if (i % 3 == 0) text += " andnotx";
+    if (i % 4 == 0) text += " andnoty";
+    DocumentID id = GetDocumentID();
+    if (i % 3 != 0) {
+      expect_x.push_front(id);
+      if (i % 4 != 0) expect_xy.push_front(id);
+    }
+    documents.push_back(
+        TestUtil::NewDocument(id, text, base, base + 100, base));
+  }
+  bool ret = index->index_writer_->AddOrUpdateDocuments(table, documents,
+                                                        nullptr, nullptr);
+  EXPECT_TRUE(ret);
+
+  wwsearch::Searcher searcher(&index->Config());
+  wwsearch::BooleanQuery all(1, "andnotall");
+  wwsearch::BooleanQuery x(1, "andnotx");
+  wwsearch::BooleanQuery y(1, "andnoty");
+  wwsearch::BooleanQuery none(1, "andnotnone");
+  {
+    wwsearch::AndNotQuery query;
+    query.AddQuery(&all);
+    query.AddNotQuery(&x);
+    auto status = searcher.DoQuery(table, query, 0, 100, nullptr, nullptr,
+                                   match_documentsid);
+    EXPECT_EQ(0, status.GetCode());
+    EXPECT_EQ(13, match_documentsid.size());
+    EXPECT_TRUE(expect_x == match_documentsid);
+  }
+  {
+    // excluded doc lists are unioned,missing term excludes nothing.
+    wwsearch::AndNotQuery query;
+    query.AddQuery(&all);
+    query.AddNotQuery(&x);
+    query.AddNotQuery(&y);
+    query.AddNotQuery(&none);
+    match_documentsid.clear();
+    auto status = searcher.DoQuery(table, query, 0, 100, nullptr, nullptr,
+                                   match_documentsid);
+    EXPECT_EQ(0, status.GetCode());
+    EXPECT_TRUE(expect_xy == match_documentsid);
+
+    // required part is a sub query too,paging works on top of it.
+    wwsearch::AndQuery and_query;
+    and_query.AddQuery(&query);
+    and_query.AddQuery(&all);
+    match_documentsid.clear();
+    status = searcher.DoQuery(table, and_query, 2, 3, nullptr, nullptr,
+                              match_documentsid);
+    EXPECT_EQ(0, status.GetCode());
+    std::list<DocumentID> expect_page(std::next(expect_xy.begin(), 2),
+                                      std::next(expect_xy.begin(), 5));
+    EXPECT_TRUE(expect_page == match_documentsid);
+  }
+  {
+    wwsearch::AndNotQuery query;
+    query.AddQuery(&none);
+    query.AddNotQuery(&x);
+    match_documentsid.clear();
+    auto status = searcher.DoQuery(table, query, 0, 100, nullptr, nullptr,
+                                   match_documentsid);
+    EXPECT_EQ(0, status.GetCode());
+    EXPECT_TRUE(match_documentsid.empty());
+  }
+}
+
+TEST_F(OrAndQueryTest, Min_Should_Match_Query) {
+  VariableChange();
+  auto base = GetNumeric(10000);
+  const char *words[] = {"msmwa", "msmwb", "msmwc", "msmwd", "msmwe"};
+  // doc i has words of bits of i.
+  std::vector<DocumentID> ids;
+  for (int i = 0; i < 32; i++) {
+    std::string text = "msmall";
+    for (int j = 0; j < 5; j++) {
+      if (i & (1 << j)) text = text + " " + words[j];
+    }
+    ids.push_back(GetDocumentID());
+    documents.push_back(
+        TestUtil::NewDocument(ids.back(), text, base, base + 100, base));
+  }
+  bool ret = index->index_writer_->AddOrUpdateDocuments(table, documents,
+                                                        nullptr, nullptr);
+  EXPECT_TRUE(ret);
+
+  wwsearch::Searcher searcher(&index->Config());
+  std::vector<wwsearch::BooleanQuery *> terms;
+  for (int j = 0; j < 5; j++) {
+    terms.push_back(new wwsearch::BooleanQuery(1, words[j]));
+  }
+  wwsearch::BooleanQuery missing(1, "msmwnone");
+  for (uint32_t k : {1, 2, 4, 5, 6}) {
+    wwsearch::MinShouldMatchQuery query(k);
+    for (auto term : terms) query.AddQuery(term);
+    query.AddQuery(&missing);
+    std::list<DocumentID> expect;
+    for (int i = 0; i < 32; i++) {
+      if (__builtin_popcount(i) >= k) expect.push_front(ids[i]);
+    }
+    match_documentsid.clear();
+    auto status = searcher.DoQuery(table, query, 0, 100, nullptr, nullptr,
+                                   match_documentsid);
+    EXPECT_EQ(0, status.GetCode());
+    EXPECT_TRUE(expect == match_documentsid) << "k=" << k;
+  }
+
+  // 2 of 5,match is in one of 4 cheapest doc lists.
+  auto snapshot = index->vdb_->NewSnapshot();
+  SearchContext context(table, index->vdb_, snapshot, &index->Config());
+  wwsearch::MinShouldMatchQuery query(2);
+  for (auto term : terms) query.AddQuery(term);
+  Weight *weight = query.CreateWeight(&context, false, 0);
+  Scorer *scorer = weight->GetScorer(&context);
+  ASSERT_NE(nullptr, scorer);
+  EXPECT_EQ(16 * 4, scorer->Iterator().Cost());
+  delete scorer;
+  delete weight;
+  index->vdb_->ReleaseSnapshot(snapshot);
+  for (auto term : terms) delete term;
+}
+
 }  // namespace wwsearch
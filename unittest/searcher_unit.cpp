@@ -17,11 +17,17 @@
  */
 
 #include <gtest/gtest.h>
+#include <future>
+#include <thread>
 #include "include/codec_doclist.h"
 #include "include/codec_doclist_impl.h"
 #include "include/codec_impl.h"
+#include "include/completion_list.h"
 #include "include/index_wrapper.h"
+#include "include/prefix_query.h"
+#include "include/query_result_cache.h"
 #include "include/search_util.h"
+#include "include/thread_pool.h"
 #include "unittest_util.h"
 
 extern bool g_debug;
@@ -401,4 +407,847 @@ TEST_F(SearcherTest, DocListReaderCodecImplTest2) {
     EXPECT_EQ(3, reader.Advance(target));
   }
 }
+
+TEST_F(SearcherTest, QueryResultCache) {
+  QueryResultCache cache(1 << 20);
+  index->Config().SetQueryResultCache(&cache);
+
+  auto base = GetNumeric(10000);
+  for (int i = 0; i < 5; i++) {
+    documents.push_back(TestUtil::NewDocument(GetDocumentID(), "cached", base,
+                                              base + i, base));
+  }
+  bool ret = index->index_writer_->AddOrUpdateDocuments(table, documents,
+                                                        nullptr, nullptr);
+  EXPECT_TRUE(ret);
+
+  wwsearch::Searcher searcher(&index->Config());
+  wwsearch::BooleanQuery query(1, "cached");
+  std::vector<Filter *> filters;
+  RangeFilter range_filter(base + 1, base + 10);
+  range_filter.GetField()->SetMeta(3, IndexFieldFlag());
+  filters.push_back(&range_filter);
+
+  std::list<DocumentID> first_docs;
+  uint32_t first_total = 0;
+  auto status = searcher.DoQuery(table, query, 0, 10, &filters, nullptr,
+                                 first_docs, nullptr, SIZE_MAX, 0, nullptr,
+                                 &first_total);
+  EXPECT_EQ(0, status.GetCode());
+  EXPECT_EQ(4, first_docs.size());
+  EXPECT_EQ(0, cache.Hits());
+  EXPECT_EQ(1, cache.Misses());
+
+  // same request hit
+  uint32_t total = 0;
+  status = searcher.DoQuery(table, query, 0, 10, &filters, nullptr,
+                            match_documentsid, nullptr, SIZE_MAX, 0, nullptr,
+                            &total);
+  EXPECT_EQ(0, status.GetCode());
+  EXPECT_EQ(1, cache.Hits());
+  EXPECT_EQ(first_docs, match_documentsid);
+  EXPECT_EQ(first_total, total);
+
+  // different limit miss
+  match_documentsid.clear();
+  status = searcher.DoQuery(table, query, 0, 2, &filters, nullptr,
+                            match_documentsid);
+  EXPECT_EQ(2, match_documentsid.size());
+  EXPECT_EQ(2, cache.Misses());
+
+  // write to table invalidate cache
+  DocumentUpdater *du =
+      TestUtil::NewDocument(GetDocumentID(), "cached", base, base + 5, base);
+  std::vector<DocumentUpdater *> new_documents{du};
+  ret = index->index_writer_->AddOrUpdateDocuments(table, new_documents,
+                                                   nullptr, nullptr);
+  EXPECT_TRUE(ret);
+  documents.push_back(du);
+  match_documentsid.clear();
+  status = searcher.DoQuery(table, query, 0, 10, &filters, nullptr,
+                            match_documentsid);
+  EXPECT_EQ(0, status.GetCode());
+  EXPECT_EQ(5, match_documentsid.size());
+  EXPECT_EQ(1, cache.Hits());
+  EXPECT_EQ(3, cache.Misses());
+
+  // so does store_buffer flushed by writer.
+  du = TestUtil::NewDocument(GetDocumentID(), "cached", base, base + 6, base);
+  new_documents.assign(1, du);
+  std::string store_buffer;
+  ret = index->index_writer_->AddOrUpdateDocuments(table, new_documents,
+                                                   &store_buffer, nullptr);
+  EXPECT_TRUE(ret);
+  documents.push_back(du);
+  status = index->index_writer_->FlushStoreBuffer(table, store_buffer);
+  EXPECT_EQ(0, status.GetCode());
+  match_documentsid.clear();
+  status = searcher.DoQuery(table, query, 0, 10, &filters, nullptr,
+                            match_documentsid);
+  EXPECT_EQ(6, match_documentsid.size());
+  EXPECT_EQ(1, cache.Hits());
+  EXPECT_EQ(4, cache.Misses());
+
+  // cache is not used while table is being written.
+  TableVersion *table_version = index->Config().GetTableVersion();
+  table_version->BeginWrite(table);
+  EXPECT_EQ(TableVersion::kNoVersion, table_version->Get(table));
+  match_documentsid.clear();
+  status = searcher.DoQuery(table, query, 0, 10, &filters, nullptr,
+                            match_documentsid);
+  EXPECT_EQ(6, match_documentsid.size());
+  EXPECT_EQ(1, cache.Hits());
+  EXPECT_EQ(4, cache.Misses());
+  table_version->EndWrite(table);
+
+  index->Config().SetQueryResultCache(nullptr);
+
+  // memory bounded,oldest entry is evicted.
+  QueryResultCache small_cache(512);
+  std::list<DocumentID> docs{3, 2, 1};
+  for (int i = 0; i < 100; i++) {
+    small_cache.Put(table, std::to_string(i), 0, docs, 0);
+  }
+  EXPECT_LE(small_cache.UsageBytes(), 512);
+  EXPECT_GT(small_cache.Size(), 0);
+  match_documentsid.clear();
+  EXPECT_TRUE(small_cache.Get(table, "99", 0, match_documentsid, nullptr));
+  EXPECT_EQ(docs, match_documentsid);
+  EXPECT_FALSE(small_cache.Get(table, "0", 0, match_documentsid, nullptr));
+}
+
+TEST_F(SearcherTest, ParallelQuery) {
+  auto base = GetNumeric(10000);
+  for (int i = 0; i < 40; i++) {
+    documents.push_back(TestUtil::NewDocument(
+        GetDocumentID(), "parallel", base, base + (i * 7) % 40, base));
+  }
+  bool ret = index->index_writer_->AddOrUpdateDocuments(table, documents,
+                                                        nullptr, nullptr);
+  EXPECT_TRUE(ret);
+
+  wwsearch::Searcher searcher(&index->Config());
+  wwsearch::BooleanQuery query(1, "parallel");
+  std::vector<Filter *> filters;
+  RangeFilter range_filter(base + 3, base + 30);
+  range_filter.GetField()->SetMeta(3, IndexFieldFlag());
+  filters.push_back(&range_filter);
+  NumericSortCondition sort_condition(3, kSortConditionDesc);
+  std::vector<SortCondition *> sorter{&sort_condition};
+
+  auto run = [&](std::vector<SortCondition *> *sort, size_t offset,
+                 size_t limit, std::list<DocumentID> &docs, uint32_t &total) {
+    total = 0;
+    auto status = searcher.DoQuery(table, query, offset, limit, &filters,
+                                   sort, docs, nullptr, SIZE_MAX, 0, nullptr,
+                                   &total);
+    EXPECT_EQ(0, status.GetCode());
+  };
+
+  std::list<DocumentID> serial_sorted, serial_paged, serial_unsorted;
+  uint32_t serial_total = 0;
+  run(&sorter, 0, 10, serial_sorted, serial_total);
+  EXPECT_EQ(10, serial_sorted.size());
+  EXPECT_EQ(28, serial_total);
+  run(&sorter, 5, 10, serial_paged, serial_total);
+  run(nullptr, 0, 10, serial_unsorted, serial_total);
+
+  ThreadPool pool(3);
+  index->Config().SetQueryThreadPool(&pool);
+  index->Config().SetMinParallelPartitionDocs(5);
+  std::list<DocumentID> docs;
+  uint32_t total = 0;
+  run(&sorter, 0, 10, docs, total);
+  EXPECT_EQ(serial_sorted, docs);
+  EXPECT_EQ(28, total);
+  docs.clear();
+  run(&sorter, 5, 10, docs, total);
+  EXPECT_EQ(serial_paged, docs);
+  docs.clear();
+  run(nullptr, 0, 10, docs, total);
+  EXPECT_EQ(serial_unsorted, docs);
+  EXPECT_EQ(28, total);
+
+  // query from the only worker of pool runs queued ranges itself.
+  ThreadPool single_pool(1);
+  index->Config().SetQueryThreadPool(&single_pool);
+  std::promise<std::list<DocumentID>> worker_docs;
+  single_pool.Submit([&] {
+    std::list<DocumentID> docs;
+    uint32_t total = 0;
+    run(&sorter, 0, 10, docs, total);
+    worker_docs.set_value(docs);
+  });
+  auto future = worker_docs.get_future();
+  ASSERT_EQ(std::future_status::ready,
+            future.wait_for(std::chrono::seconds(10)));
+  EXPECT_EQ(serial_sorted, future.get());
+
+  index->Config().SetQueryThreadPool(nullptr);
+  index->Config().SetMinParallelPartitionDocs(10000);
+}
+
+TEST_F(SearcherTest, MultiTableQuery) {
+  auto base = GetNumeric(10000);
+  std::vector<TableID> tables;
+  std::map<uint64_t, std::pair<TableID, DocumentID>> value_docs;
+  for (int t = 0; t < 3; t++) {
+    TableID sub_table = table;
+    sub_table.partition_set += 100000 * (t + 1);
+    tables.push_back(sub_table);
+    std::vector<DocumentUpdater *> table_documents;
+    for (int i = 0; i < 4; i++) {
+      uint64_t value = base + i * 3 + t;
+      DocumentID id = GetDocumentID();
+      value_docs[value] = std::make_pair(sub_table, id);
+      table_documents.push_back(
+          TestUtil::NewDocument(id, "fanout", base, value, base));
+    }
+    bool ret = index->index_writer_->AddOrUpdateDocuments(
+        sub_table, table_documents, nullptr, nullptr);
+    EXPECT_TRUE(ret);
+    documents.insert(documents.end(), table_documents.begin(),
+                     table_documents.end());
+  }
+
+  wwsearch::Searcher searcher(&index->Config());
+  wwsearch::BooleanQuery query(1, "fanout");
+  NumericSortCondition sort_condition(3, kSortConditionDesc);
+  std::vector<SortCondition *> sorter{&sort_condition};
+  std::list<std::pair<TableID, DocumentID>> expect;
+  for (uint64_t value = base + 9; value >= base + 6; value--) {
+    expect.push_back(value_docs[value]);
+  }
+  auto check = [&](const std::list<std::pair<TableID, DocumentID>> &docs) {
+    ASSERT_EQ(expect.size(), docs.size());
+    auto iter = expect.begin();
+    for (auto &doc : docs) {
+      EXPECT_EQ(iter->first.partition_set, doc.first.partition_set);
+      EXPECT_EQ(iter->second, doc.second);
+      ++iter;
+    }
+  };
+
+  std::list<std::pair<TableID, DocumentID>> docs;
+  uint32_t total = 0;
+  auto status = searcher.DoQuery(tables, query, 2, 4, nullptr, &sorter, docs,
+                                 0, nullptr, &total);
+  EXPECT_EQ(0, status.GetCode());
+  EXPECT_EQ(12, total);
+  check(docs);
+
+  ThreadPool pool(2);
+  index->Config().SetQueryThreadPool(&pool);
+  docs.clear();
+  total = 0;
+  status = searcher.DoQuery(tables, query, 2, 4, nullptr, &sorter, docs, 0,
+                            nullptr, &total);
+  index->Config().SetQueryThreadPool(nullptr);
+  EXPECT_EQ(0, status.GetCode());
+  EXPECT_EQ(12, total);
+  check(docs);
+}
+
+TEST_F(SearcherTest, BatchQuery) {
+  auto base = GetNumeric(10000);
+  for (int i = 0; i < 8; i++) {
+    documents.push_back(TestUtil::NewDocument(
+        GetDocumentID(), i < 5 ? "batcha" : "batchb", base, base + i, base));
+  }
+  bool ret = index->index_writer_->AddOrUpdateDocuments(table, documents,
+                                                        nullptr, nullptr);
+  EXPECT_TRUE(ret);
+
+  wwsearch::Searcher searcher(&index->Config());
+  wwsearch::BooleanQuery query_a(1, "batcha");
+  wwsearch::BooleanQuery query_a2(1, "batcha");
+  wwsearch::BooleanQuery query_b(1, "batchb");
+  wwsearch::BooleanQuery query_miss(1, "batchmiss");
+  std::vector<Filter *> filters;
+  RangeFilter range_filter(base + 1, base + 6);
+  range_filter.GetField()->SetMeta(3, IndexFieldFlag());
+  filters.push_back(&range_filter);
+  NumericSortCondition sort_condition(3, kSortConditionAsc);
+  std::vector<SortCondition *> sorter{&sort_condition};
+
+  std::vector<SearchRequest> requests;
+  requests.emplace_back(&query_a, 0, 10, &filters);
+  requests.back().need_match_total_cnt = true;
+  requests.emplace_back(&query_a2, 1, 2, nullptr, &sorter);
+  requests.emplace_back(&query_b, 0, 10, &filters, &sorter);
+  requests.emplace_back(&query_miss, 0, 10);
+  SearchTracer tracer;
+  auto status = searcher.DoQueries(table, requests, &tracer);
+  EXPECT_EQ(0, status.GetCode());
+  // only batcha is read by more than one query.
+  EXPECT_EQ(1, tracer.Get(TracerType::kGetInvertedTableSubQueryCount));
+
+  for (auto &request : requests) {
+    std::list<DocumentID> docs;
+    uint32_t total = 0;
+    auto single_status = searcher.DoQuery(
+        table, *request.query, request.offset, request.limit, request.filter,
+        request.sorter, docs, nullptr, SIZE_MAX, 0, nullptr,
+        request.need_match_total_cnt ? &total : nullptr);
+    EXPECT_EQ(single_status.GetCode(), request.status.GetCode());
+    EXPECT_EQ(docs, request.docs);
+    EXPECT_EQ(total, request.match_total_cnt);
+  }
+  EXPECT_EQ(4, requests[0].docs.size());
+  EXPECT_EQ(4, requests[0].match_total_cnt);
+  EXPECT_EQ(2, requests[1].docs.size());
+  EXPECT_EQ(2, requests[2].docs.size());
+  EXPECT_EQ(0, requests[3].docs.size());
+
+  // nothing is kept if cache is full,results are same.
+  std::vector<SearchRequest> uncached_requests;
+  for (auto &request : requests) {
+    uncached_requests.emplace_back(request.query, request.offset,
+                                   request.limit, request.filter,
+                                   request.sorter);
+    uncached_requests.back().need_match_total_cnt =
+        request.need_match_total_cnt;
+  }
+  index->Config().SetMaxBatchReadCacheBytes(0);
+  status = searcher.DoQueries(table, uncached_requests, nullptr);
+  index->Config().SetMaxBatchReadCacheBytes(64 << 20);
+  EXPECT_EQ(0, status.GetCode());
+  for (size_t i = 0; i < requests.size(); i++) {
+    EXPECT_EQ(requests[i].docs, uncached_requests[i].docs);
+    EXPECT_EQ(requests[i].match_total_cnt,
+              uncached_requests[i].match_total_cnt);
+  }
+}
+
+TEST_F(SearcherTest, CountQuery) {
+  auto base = GetNumeric(10000);
+  for (int i = 0; i < 30; i++) {
+    documents.push_back(TestUtil::NewDocument(
+        GetDocumentID(), i < 20 ? "counta" : "countb", base, base + i % 3,
+        base));
+  }
+  bool ret = index->index_writer_->AddOrUpdateDocuments(table, documents,
+                                                        nullptr, nullptr);
+  EXPECT_TRUE(ret);
+
+  wwsearch::Searcher searcher(&index->Config());
+  wwsearch::BooleanQuery query_a(1, "counta");
+  wwsearch::BooleanQuery query_b(1, "countb");
+  uint64_t count = 0;
+  SearchTracer tracer;
+  auto status = searcher.DoCount(table, query_a, nullptr, count, 0, &tracer);
+  EXPECT_EQ(0, status.GetCode());
+  EXPECT_EQ(20, count);
+  EXPECT_EQ(0, tracer.Get(TracerType::kGetDocvalueCountInCollector));
+
+  wwsearch::OrQuery or_query;
+  or_query.AddQuery(&query_a);
+  or_query.AddQuery(&query_b);
+  status = searcher.DoCount(table, or_query, nullptr, count);
+  EXPECT_EQ(0, status.GetCode());
+  EXPECT_EQ(30, count);
+
+  // inverted indexed filter is pushed down,no docvalue read.
+  IndexFieldFlag flag;
+  flag.SetInvertIndex();
+  EqualFilter equal;
+  equal.GetField()->SetMeta(3, flag);
+  equal.GetField()->SetUint32(base + 1);
+  std::vector<Filter *> filters{&equal};
+  tracer.Clear();
+  status = searcher.DoCount(table, query_a, &filters, count, 0, &tracer);
+  EXPECT_EQ(0, status.GetCode());
+  EXPECT_EQ(7, count);
+  EXPECT_EQ(0, tracer.Get(TracerType::kGetDocvalueCountInCollector));
+
+  // not indexed filter falls back to docvalue.
+  EqualFilter docvalue_equal;
+  docvalue_equal.GetField()->SetMeta(3, IndexFieldFlag());
+  docvalue_equal.GetField()->SetUint32(base + 1);
+  filters[0] = &docvalue_equal;
+  tracer.Clear();
+  status = searcher.DoCount(table, query_a, &filters, count, 0, &tracer);
+  EXPECT_EQ(0, status.GetCode());
+  EXPECT_EQ(7, count);
+  EXPECT_EQ(20, tracer.Get(TracerType::kGetDocvalueCountInCollector));
+}
+
+TEST_F(SearcherTest, HitEstimate) {
+  auto base = GetNumeric(10000);
+  for (int i = 0; i < 400; i++) {
+    documents.push_back(TestUtil::NewDocument(GetDocumentID(), "estimate",
+                                              base, base + i % 2, base));
+  }
+  bool ret = index->index_writer_->AddOrUpdateDocuments(table, documents,
+                                                        nullptr, nullptr);
+  EXPECT_TRUE(ret);
+
+  wwsearch::Searcher searcher(&index->Config());
+  wwsearch::BooleanQuery query(1, "estimate");
+  std::vector<Filter *> filters;
+  RangeFilter range_filter(base + 1, base + 1);
+  range_filter.GetField()->SetMeta(3, IndexFieldFlag());
+  filters.push_back(&range_filter);
+
+  HitEstimate estimate;
+  auto status = searcher.DoQuery(table, query, 0, 10, &filters, nullptr,
+                                 match_documentsid, nullptr, SIZE_MAX, 0,
+                                 nullptr, nullptr, &estimate);
+  EXPECT_EQ(0, status.GetCode());
+  EXPECT_EQ(10, match_documentsid.size());
+  EXPECT_TRUE(estimate.exact);
+  EXPECT_EQ(200, estimate.total);
+  EXPECT_EQ(0, estimate.error_bound);
+
+  // only first 100 documents are filtered,the rest are extrapolated.
+  uint32_t old_limit = index->Config().GetMaxInnerPurgeDocsTotalLimit();
+  index->Config().SetMaxInnerPurgeDocsTotalLimit(99);
+  std::list<DocumentID> docs;
+  uint32_t total = 0;
+  status = searcher.DoQuery(table, query, 0, 10, &filters, nullptr, docs,
+                            nullptr, SIZE_MAX, 0, nullptr, &total, &estimate);
+  index->Config().SetMaxInnerPurgeDocsTotalLimit(old_limit);
+  EXPECT_EQ(0, status.GetCode());
+  EXPECT_EQ(match_documentsid, docs);
+  EXPECT_EQ(50, total);
+  EXPECT_FALSE(estimate.exact);
+  EXPECT_GT(estimate.error_bound, 0);
+  EXPECT_LE(estimate.total, 200 + estimate.error_bound);
+  EXPECT_GE(estimate.total + estimate.error_bound, 200);
+}
+
+TEST_F(SearcherTest, SearchAfterCursor) {
+  auto base = GetNumeric(10000);
+  for (int i = 0; i < 23; i++) {
+    documents.push_back(TestUtil::NewDocument(GetDocumentID(), "cursor", base,
+                                              base + i % 5, base));
+  }
+  bool ret = index->index_writer_->AddOrUpdateDocuments(table, documents,
+                                                        nullptr, nullptr);
+  EXPECT_TRUE(ret);
+
+  wwsearch::Searcher searcher(&index->Config());
+  wwsearch::BooleanQuery query(1, "cursor");
+  std::vector<Filter *> filters;
+  RangeFilter range_filter(base + 1, base + 4);
+  range_filter.GetField()->SetMeta(3, IndexFieldFlag());
+  filters.push_back(&range_filter);
+  NumericSortCondition sort_condition(3, kSortConditionDesc);
+  std::vector<SortCondition *> sorter{&sort_condition};
+
+  wwsearch::Query *current = &query;
+  auto check = [&](std::vector<Filter *> *filter,
+                   std::vector<SortCondition *> *sort) {
+    std::list<DocumentID> expect;
+    auto status =
+        searcher.DoQuery(table, *current, 0, 100, filter, sort, expect);
+    EXPECT_EQ(0, status.GetCode());
+
+    std::list<DocumentID> pages;
+    std::string cursor;
+    size_t page_num = 0;
+    do {
+      std::list<DocumentID> page;
+      status = searcher.DoQueryAfter(table, *current, 5, filter, sort, cursor,
+                                     page);
+      EXPECT_EQ(0, status.GetCode());
+      EXPECT_LE(page.size(), 5);
+      pages.splice(pages.end(), page);
+      page_num++;
+    } while (!cursor.empty() && page_num < 10);
+    EXPECT_EQ(expect, pages);
+  };
+  check(nullptr, nullptr);
+  check(&filters, nullptr);
+  check(nullptr, &sorter);
+  check(&filters, &sorter);
+
+  // cursor of other sorter is rejected.
+  std::string cursor;
+  std::list<DocumentID> page;
+  auto status =
+      searcher.DoQueryAfter(table, query, 5, nullptr, nullptr, cursor, page);
+  EXPECT_EQ(0, status.GetCode());
+  EXPECT_FALSE(cursor.empty());
+  status =
+      searcher.DoQueryAfter(table, query, 5, nullptr, &sorter, cursor, page);
+  EXPECT_EQ(kDataErrorStatus, status.GetCode());
+
+  // sort by index sort field pages in doc id order too.
+  std::vector<DocumentUpdater *> sorted_documents;
+  for (int i = 0; i < 23; i++) {
+    sorted_documents.push_back(TestUtil::NewDocument(
+        GetDocumentID(), "cursorsorted", base, base + i / 2, base));
+  }
+  ret = index->index_writer_->AddOrUpdateDocuments(table, sorted_documents,
+                                                   nullptr, nullptr);
+  EXPECT_TRUE(ret);
+  documents.insert(documents.end(), sorted_documents.begin(),
+                   sorted_documents.end());
+  wwsearch::BooleanQuery sorted_query(1, "cursorsorted");
+  current = &sorted_query;
+  index->Config().SetIndexSortField(3);
+  check(nullptr, &sorter);
+  check(&filters, &sorter);
+  index->Config().SetIndexSortField(-1);
+}
+
+TEST_F(SearcherTest, Aggregation) {
+  for (int i = 0; i < 20; i++) {
+    documents.push_back(
+        TestUtil::NewDocument(GetDocumentID(), "agg", i % 3, i, 100));
+  }
+  bool ret = index->index_writer_->AddOrUpdateDocuments(table, documents,
+                                                        nullptr, nullptr);
+  EXPECT_TRUE(ret);
+
+  wwsearch::Searcher searcher(&index->Config());
+  wwsearch::BooleanQuery query(1, "agg");
+  Aggregation terms;
+  terms.GroupByTerms(2);
+  terms.AddMetric(kAggregationSum, 3);
+  terms.AddMetric(kAggregationMin, 3);
+  terms.AddMetric(kAggregationMax, 3);
+  terms.SetMaxBuckets(2);
+  Aggregation histogram;
+  histogram.GroupByHistogram(3, 5);
+  histogram.AddMetric(kAggregationCount, 4);
+  Aggregation string_terms;
+  string_terms.GroupByTerms(1);
+  string_terms.AddMetric(kAggregationCount, 1);
+  string_terms.AddMetric(kAggregationMin, 1);
+  std::vector<Aggregation *> aggregations{&terms, &histogram, &string_terms};
+  auto status =
+      searcher.DoAggregation(table, query, nullptr, aggregations, 0, nullptr);
+  EXPECT_EQ(0, status.GetCode());
+
+  std::vector<AggregationBucket> buckets;
+  terms.GetBuckets(buckets);
+  ASSERT_EQ(2, buckets.size());
+  // 0,3,...,18 and 1,4,...,19
+  EXPECT_EQ(0, buckets[0].numeric_key);
+  EXPECT_EQ(7, buckets[0].doc_count);
+  EXPECT_EQ(63, buckets[0].metrics[0].Value(kAggregationSum));
+  EXPECT_EQ(0, buckets[0].metrics[1].Value(kAggregationMin));
+  EXPECT_EQ(18, buckets[0].metrics[2].Value(kAggregationMax));
+  EXPECT_EQ(1, buckets[1].numeric_key);
+  EXPECT_EQ(70, buckets[1].metrics[0].Value(kAggregationSum));
+
+  buckets.clear();
+  histogram.GetBuckets(buckets);
+  ASSERT_EQ(4, buckets.size());
+  for (size_t i = 0; i < buckets.size(); i++) {
+    EXPECT_EQ(i * 5, buckets[i].numeric_key);
+    EXPECT_EQ(5, buckets[i].doc_count);
+    EXPECT_EQ(5, buckets[i].metrics[0].Value(kAggregationCount));
+  }
+
+  buckets.clear();
+  string_terms.GetBuckets(buckets);
+  ASSERT_EQ(1, buckets.size());
+  EXPECT_TRUE(buckets[0].is_string);
+  EXPECT_EQ("agg", buckets[0].string_key);
+  EXPECT_EQ(20, buckets[0].doc_count);
+  // string field is counted,but has no min.
+  EXPECT_EQ(20, buckets[0].metrics[0].Value(kAggregationCount));
+  EXPECT_EQ(0, buckets[0].metrics[1].Value(kAggregationMin));
+
+  // filter before aggregate.
+  Aggregation total;
+  total.AddMetric(kAggregationSum, 3);
+  std::vector<Aggregation *> total_aggregations{&total};
+  std::vector<Filter *> filters;
+  RangeFilter range_filter(0, 9);
+  range_filter.GetField()->SetMeta(3, IndexFieldFlag());
+  filters.push_back(&range_filter);
+  status = searcher.DoAggregation(table, query, &filters, total_aggregations);
+  EXPECT_EQ(0, status.GetCode());
+  buckets.clear();
+  total.GetBuckets(buckets);
+  ASSERT_EQ(1, buckets.size());
+  EXPECT_EQ(10, buckets[0].doc_count);
+  EXPECT_EQ(45, buckets[0].metrics[0].Value(kAggregationSum));
+}
+
+TEST_F(SearcherTest, Facet) {
+  for (int i = 0; i < 60; i++) {
+    // field 2 : 0 unread,1 read.field 3 : starred every 4.
+    documents.push_back(TestUtil::NewDocument(
+        GetDocumentID(), i < 40 ? "inbox" : "sent", i % 2, i % 4 == 0, i));
+  }
+  bool ret = index->index_writer_->AddOrUpdateDocuments(table, documents,
+                                                        nullptr, nullptr);
+  EXPECT_TRUE(ret);
+
+  wwsearch::Searcher searcher(&index->Config());
+  wwsearch::BooleanQuery query(1, "inbox");
+  wwsearch::BooleanQuery unread(2, (uint32_t)0);
+  wwsearch::BooleanQuery read(2, (uint32_t)1);
+  wwsearch::BooleanQuery starred(3, (uint32_t)1);
+  wwsearch::BooleanQuery missing(3, (uint32_t)9);
+  std::vector<BooleanQuery *> facets{&unread, &read, &starred, &missing};
+  std::vector<uint64_t> counts;
+  SearchTracer tracer;
+  auto status = searcher.DoFacet(table, query, facets, counts, &tracer);
+  EXPECT_EQ(0, status.GetCode());
+  std::vector<uint64_t> expect{20, 20, 10, 0};
+  EXPECT_EQ(expect, counts);
+  EXPECT_EQ(0, tracer.Get(TracerType::kGetDocvalueCountInCollector));
+
+  wwsearch::BooleanQuery sent(1, "sent");
+  status = searcher.DoFacet(table, sent, facets, counts);
+  EXPECT_EQ(0, status.GetCode());
+  expect = {10, 10, 5, 0};
+  EXPECT_EQ(expect, counts);
+
+  // small match set is searched in term doc list.
+  wwsearch::BooleanQuery single(4, (uint32_t)7);
+  status = searcher.DoFacet(table, single, facets, counts);
+  EXPECT_EQ(0, status.GetCode());
+  expect = {0, 1, 0, 0};
+  EXPECT_EQ(expect, counts);
+
+  SearchDeadline cancelled;
+  cancelled.Cancel();
+  status = searcher.DoFacet(table, query, facets, counts, nullptr, &cancelled);
+  EXPECT_EQ(kQueryCancelledStatus, status.GetCode());
+  expect = {0, 0, 0, 0};
+  EXPECT_EQ(expect, counts);
+}
+
+TEST_F(SearcherTest, Deadline) {
+  auto base = GetNumeric(10000);
+  for (int i = 0; i < 50; i++) {
+    documents.push_back(TestUtil::NewDocument(GetDocumentID(), "deadline",
+                                              base, base + i % 2, base));
+  }
+  bool ret = index->index_writer_->AddOrUpdateDocuments(table, documents,
+                                                        nullptr, nullptr);
+  EXPECT_TRUE(ret);
+
+  wwsearch::Searcher searcher(&index->Config());
+  wwsearch::BooleanQuery query(1, "deadline");
+  std::vector<Filter *> filters;
+  RangeFilter range_filter(base + 1, base + 1);
+  range_filter.GetField()->SetMeta(3, IndexFieldFlag());
+  filters.push_back(&range_filter);
+
+  SearchDeadline enough(60 * 1000 * 1000);
+  auto status = searcher.DoQuery(table, query, 0, 10, &filters, nullptr,
+                                 match_documentsid, nullptr, SIZE_MAX, 0,
+                                 nullptr, nullptr, nullptr, &enough);
+  EXPECT_EQ(0, status.GetCode());
+  EXPECT_EQ(10, match_documentsid.size());
+
+  SearchDeadline cancelled;
+  cancelled.Cancel();
+  std::list<DocumentID> docs;
+  status = searcher.DoQuery(table, query, 0, 10, &filters, nullptr, docs,
+                            nullptr, SIZE_MAX, 0, nullptr, nullptr, nullptr,
+                            &cancelled);
+  EXPECT_EQ(kQueryCancelledStatus, status.GetCode());
+  EXPECT_TRUE(status.Interrupted());
+  EXPECT_TRUE(docs.empty());
+
+  SearchDeadline timeout(1);
+  std::this_thread::sleep_for(std::chrono::milliseconds(2));
+  wwsearch::PrefixQuery prefix(1, "dead");
+  status = searcher.DoQuery(table, prefix, 0, 10, nullptr, nullptr, docs,
+                            nullptr, SIZE_MAX, 0, nullptr, nullptr, nullptr,
+                            &timeout);
+  EXPECT_EQ(kQueryTimeoutStatus, status.GetCode());
+  EXPECT_TRUE(docs.empty());
+}
+
+TEST_F(SearcherTest, AsyncQuery) {
+  auto base = GetNumeric(10000);
+  for (int i = 0; i < 40; i++) {
+    documents.push_back(TestUtil::NewDocument(GetDocumentID(), "async", base,
+                                              base + (i * 7) % 40, base));
+  }
+  bool ret = index->index_writer_->AddOrUpdateDocuments(table, documents,
+                                                        nullptr, nullptr);
+  EXPECT_TRUE(ret);
+
+  wwsearch::Searcher searcher(&index->Config());
+  wwsearch::BooleanQuery query(1, "async");
+  std::vector<Filter *> filters;
+  RangeFilter range_filter(base + 3, base + 30);
+  range_filter.GetField()->SetMeta(3, IndexFieldFlag());
+  filters.push_back(&range_filter);
+  NumericSortCondition sort_condition(3, kSortConditionDesc);
+  std::vector<SortCondition *> sorter{&sort_condition};
+
+  auto status = searcher.DoQueryAsync(
+      table, query, 0, 10, &filters, &sorter,
+      [](SearchStatus &status, std::list<DocumentID> &docs) {});
+  EXPECT_FALSE(status.OK());
+
+  // several stages per query.
+  uint32_t old_batch = index->Config().GetMaxInnerPurgeBatchDocsCount();
+  index->Config().SetMaxInnerPurgeBatchDocsCount(7);
+  ThreadPool executor(2);
+  index->Config().SetSearchExecutor(&executor);
+
+  const size_t query_num = 8;
+  std::vector<std::list<DocumentID>> expects(query_num), results(query_num);
+  std::vector<std::promise<int>> promises(query_num);
+  for (size_t i = 0; i < query_num; i++) {
+    std::vector<SortCondition *> *sort = (i % 2 == 0) ? &sorter : nullptr;
+    status = searcher.DoQuery(table, query, i, 5, &filters, sort, expects[i]);
+    EXPECT_EQ(0, status.GetCode());
+    status = searcher.DoQueryAsync(
+        table, query, i, 5, &filters, sort,
+        [&, i](SearchStatus &status, std::list<DocumentID> &docs) {
+          results[i].swap(docs);
+          promises[i].set_value(status.GetCode());
+        });
+    EXPECT_EQ(0, status.GetCode());
+  }
+  for (size_t i = 0; i < query_num; i++) {
+    EXPECT_EQ(0, promises[i].get_future().get());
+    EXPECT_EQ(5, results[i].size());
+    EXPECT_EQ(expects[i], results[i]);
+  }
+
+  index->Config().SetSearchExecutor(nullptr);
+  index->Config().SetMaxInnerPurgeBatchDocsCount(old_batch);
+}
+
+TEST_F(SearcherTest, DocValuePrefetch) {
+  auto base = GetNumeric(10000);
+  for (int i = 0; i < 200; i++) {
+    documents.push_back(TestUtil::NewDocument(
+        GetDocumentID(), "prefetch", base, base + (i * 7) % 40, base));
+  }
+  bool ret = index->index_writer_->AddOrUpdateDocuments(table, documents,
+                                                        nullptr, nullptr);
+  EXPECT_TRUE(ret);
+
+  wwsearch::Searcher searcher(&index->Config());
+  wwsearch::BooleanQuery query(1, "prefetch");
+  std::vector<Filter *> filters;
+  RangeFilter range_filter(base + 3, base + 12);
+  range_filter.GetField()->SetMeta(3, IndexFieldFlag());
+  filters.push_back(&range_filter);
+  NumericSortCondition sort_condition(3, kSortConditionDesc);
+  std::vector<SortCondition *> sorter{&sort_condition};
+
+  uint32_t old_batch = index->Config().GetMaxInnerPurgeBatchDocsCount();
+  index->Config().SetMaxInnerPurgeBatchDocsCount(64);
+  std::list<DocumentID> expect_sorted, expect_unsorted;
+  auto status = searcher.DoQuery(table, query, 0, 10, &filters, &sorter,
+                                 expect_sorted);
+  EXPECT_EQ(0, status.GetCode());
+  // docs come in doc id order,batch is shrunk to what top 10 needs.
+  SearchTracer tracer;
+  status = searcher.DoQuery(table, query, 0, 10, &filters, nullptr,
+                            expect_unsorted, nullptr, SIZE_MAX, 0, &tracer);
+  EXPECT_EQ(0, status.GetCode());
+  EXPECT_EQ(10, expect_unsorted.size());
+  EXPECT_LT(tracer.Get(TracerType::kGetDocvalueCountInCollector), 64);
+
+  // serial collector reads docvalue on pool.
+  ThreadPool pool(2);
+  index->Config().SetQueryThreadPool(&pool);
+  index->Config().SetQueryParallelism(1);
+  index->Config().SetMaxInnerPurgeBatchDocsCount(16);
+  std::list<DocumentID> docs;
+  uint32_t total = 0;
+  status = searcher.DoQuery(table, query, 0, 10, &filters, &sorter, docs,
+                            nullptr, SIZE_MAX, 0, nullptr, &total);
+  EXPECT_EQ(0, status.GetCode());
+  EXPECT_EQ(expect_sorted, docs);
+  EXPECT_EQ(50, total);
+  docs.clear();
+  status = searcher.DoQuery(table, query, 0, 10, &filters, nullptr, docs);
+  EXPECT_EQ(0, status.GetCode());
+  EXPECT_EQ(expect_unsorted, docs);
+
+  index->Config().SetQueryThreadPool(nullptr);
+  index->Config().SetQueryParallelism(4);
+  index->Config().SetMaxInnerPurgeBatchDocsCount(old_batch);
+}
+
+TEST_F(SearcherTest, Complete) {
+  auto base = GetNumeric(10000);
+  const char *words[] = {"compapple",   "compapple",   "compapple",
+                         "compapricot", "compapricot", "compbanana"};
+  std::vector<DocumentID> ids;
+  for (auto word : words) {
+    ids.push_back(GetDocumentID());
+    auto du = TestUtil::NewDocument(ids.back(), word, base, base, base);
+    du->New().FindField(1)->Flag().SetCompletion();
+    documents.push_back(du);
+  }
+  bool ret = index->index_writer_->AddOrUpdateDocuments(table, documents,
+                                                        nullptr, nullptr);
+  EXPECT_TRUE(ret);
+
+  typedef std::vector<std::pair<std::string, uint64_t>> Suggestions;
+  wwsearch::Searcher searcher(&index->Config());
+  auto complete = [&](const std::string &prefix, uint32_t top_k) {
+    Suggestions suggestions;
+    auto status = searcher.Complete(table, 1, prefix, top_k, suggestions);
+    EXPECT_EQ(0, status.GetCode());
+    return suggestions;
+  };
+  EXPECT_EQ(Suggestions({{"compapple", 3}, {"compapricot", 2}}),
+            complete("comp", 2));
+  EXPECT_EQ(Suggestions({{"compbanana", 1}}), complete("compb", 10));
+  // longer than indexed prefix,filtered from indexed one.
+  EXPECT_EQ(Suggestions({{"compapricot", 2}}), complete("compapric", 10));
+  EXPECT_EQ(Suggestions(), complete("compx", 10));
+
+  // update and delete change weight incrementally.
+  std::vector<DocumentUpdater *> changes;
+  changes.push_back(TestUtil::NewDocument(ids[0], "compbanana", base, base,
+                                          base));
+  changes.back()->New().FindField(1)->Flag().SetCompletion();
+  ret = index->index_writer_->AddOrUpdateDocuments(table, changes, nullptr,
+                                                   nullptr);
+  EXPECT_TRUE(ret);
+  std::vector<DocumentUpdater *> deletes;
+  deletes.push_back(TestUtil::NewDocument(ids[3], "", base, base, base));
+  deletes.push_back(TestUtil::NewDocument(ids[4], "", base, base, base));
+  ret = index->index_writer_->DeleteDocuments(table, deletes, nullptr,
+                                              nullptr);
+  EXPECT_TRUE(ret);
+  for (auto du : changes) delete du;
+  for (auto du : deletes) delete du;
+  EXPECT_EQ(Suggestions({{"compapple", 2}, {"compbanana", 2}}),
+            complete("comp", 10));
+
+  // full list keeps heavy terms,new term takes lightest slot,inherited
+  // weight is error and not reported.
+  CompletionList list(2);
+  list.Add("a", 5);
+  list.Add("b", 3);
+  list.Add("c", 1);
+  std::vector<CompletionList::Entry> entries;
+  list.TopK(10, entries);
+  EXPECT_EQ(std::vector<CompletionList::Entry>({{"a", 5}, {"c", 1}}),
+            entries);
+
+  // error survives serialization.
+  std::string value;
+  list.SerializeToBytes(value);
+  CompletionList decoded;
+  EXPECT_TRUE(decoded.Deserialize(value));
+  decoded.TopK(10, entries);
+  EXPECT_EQ(std::vector<CompletionList::Entry>({{"a", 5}, {"c", 1}}),
+            entries);
+
+  // delete of replacing term leaves no phantom weight,delete of evicted
+  // term is dropped.
+  list.Add("c", -1);
+  list.Add("b", -3);
+  list.TopK(10, entries);
+  EXPECT_EQ(std::vector<CompletionList::Entry>({{"a", 5}}), entries);
+  list.Add("d", 2);
+  list.TopK(10, entries);
+  EXPECT_EQ(std::vector<CompletionList::Entry>({{"a", 5}, {"d", 2}}),
+            entries);
+}
+
 }  // namespace wwsearch
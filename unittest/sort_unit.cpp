@@ -291,4 +291,52 @@ TEST_F(SortTest, StringSort) {
   }
 }
 
+TEST_F(SortTest, IndexSort) {
+  auto base = GetNumeric(10000);
+  // sort value never decrease as doc id increase.
+  for (int i = 0; i < 30; i++) {
+    documents.push_back(TestUtil::NewDocument(
+        GetDocumentID(), "indexsort", base + i % 2, base, base + i / 3));
+  }
+  bool ret = index->index_writer_->AddOrUpdateDocuments(table, documents,
+                                                        nullptr, nullptr);
+  EXPECT_TRUE(ret);
+
+  wwsearch::Searcher searcher(&index->Config());
+  wwsearch::BooleanQuery query(1, "indexsort");
+  wwsearch::NumericSortCondition sort_condition(4,
+                                                wwsearch::kSortConditionDesc);
+  std::vector<wwsearch::SortCondition*> sorter{&sort_condition};
+  std::vector<wwsearch::Filter*> filters;
+  wwsearch::RangeFilter range_filter(base + 1, base + 1);
+  range_filter.GetField()->SetMeta(2, wwsearch::IndexFieldFlag());
+  filters.push_back(&range_filter);
+
+  auto run = [&](std::vector<wwsearch::Filter*>* filter,
+                 std::list<DocumentID>& docs) {
+    wwsearch::SearchTracer tracer;
+    auto status = searcher.DoQuery(table, query, 2, 5, filter, &sorter, docs,
+                                   nullptr, SIZE_MAX, 0, &tracer);
+    EXPECT_EQ(0, status.GetCode());
+    EXPECT_EQ(5, docs.size());
+    return tracer.Get(wwsearch::TracerType::kGetDocvalueCountInCollector);
+  };
+
+  uint32_t old_batch = index->Config().GetMaxInnerPurgeBatchDocsCount();
+  index->Config().SetMaxInnerPurgeBatchDocsCount(4);
+  std::list<DocumentID> expect, expect_filtered;
+  EXPECT_EQ(30, run(nullptr, expect));
+  EXPECT_EQ(30, run(&filters, expect_filtered));
+
+  index->Config().SetIndexSortField(4);
+  std::list<DocumentID> docs, docs_filtered;
+  // no docvalue read without filter,stop early with filter.
+  EXPECT_EQ(0, run(nullptr, docs));
+  EXPECT_EQ(16, run(&filters, docs_filtered));
+  index->Config().SetIndexSortField(-1);
+  index->Config().SetMaxInnerPurgeBatchDocsCount(old_batch);
+  EXPECT_EQ(expect, docs);
+  EXPECT_EQ(expect_filtered, docs_filtered);
+}
+
 }  // namespace wwsearch
@@ -19,6 +19,9 @@
 #include <gtest/gtest.h>
 #include <stdlib.h>
 #include <algorithm>
+#include <set>
+#include "include/buffer_or_iterator.h"
+#include "include/codec_doclist_impl.h"
 #include "include/doclist_compression.h"
 #include "include/index_wrapper.h"
 #include "unittest_util.h"
@@ -87,4 +90,48 @@ TEST_F(UnitTest, CompressionDocList) {
   }
 }
 
+TEST_F(UnitTest, PrefixSuccessor) {
+  EXPECT_EQ(std::string("abd"), PrefixSuccessor("abc"));
+  EXPECT_EQ(std::string("b"), PrefixSuccessor(std::string("a\xff\xff")));
+  EXPECT_EQ(std::string(""), PrefixSuccessor(std::string("\xff\xff")));
+  EXPECT_EQ(std::string(""), PrefixSuccessor(""));
+}
+
+TEST_F(UnitTest, BufferOrIterator) {
+  // dense and sparse doc lists take different path in FinishAddIterator.
+  for (uint64_t step : {1ULL, 1000000ULL}) {
+    std::vector<std::string> doc_lists(3);
+    std::set<DocumentID> expect;
+    for (size_t i = 0; i < doc_lists.size(); i++) {
+      DocListOrderWriterCodecImpl writer;
+      for (uint64_t doc = 300; doc > 0; doc--) {
+        if (doc % (i + 2) != 0) continue;
+        writer.AddDocID(doc * step, kDocumentStateOK);
+        expect.insert(doc * step);
+      }
+      writer.SerializeToBytes(doc_lists[i], 0);
+    }
+
+    BufferOrIterator iterator;
+    for (auto &doc_list : doc_lists) {
+      DocListReaderCodecImpl reader(doc_list.c_str(), doc_list.size());
+      iterator.AddSubIterator(&reader);
+    }
+    iterator.FinishAddIterator();
+    EXPECT_EQ(expect.size(), iterator.Cost());
+
+    auto it = expect.rbegin();
+    for (; it != expect.rend(); ++it) {
+      EXPECT_EQ(*it, iterator.DocID());
+      iterator.NextDoc();
+    }
+    EXPECT_EQ(DocIdSetIterator::NO_MORE_DOCS, iterator.DocID());
+
+    iterator.Advance(DocIdSetIterator::MAX_DOCID);
+    EXPECT_EQ(*expect.rbegin(), iterator.DocID());
+    EXPECT_EQ(100 * step, iterator.Advance(101 * step));
+    EXPECT_EQ(DocIdSetIterator::NO_MORE_DOCS, iterator.Advance(step));
+  }
+}
+
 }  // namespace wwsearch